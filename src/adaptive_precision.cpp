@@ -0,0 +1,168 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "adaptive_precision.h"
+
+#ifndef NO_FLEXIBILITY
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+using namespace panda;
+
+namespace
+{
+   /// The conversions between the integer types go digit by digit, each digit fits into int.
+   constexpr int32_t digit_base = int32_t(1) << 30;
+   /// Converts to the checked integer type. Throws std::invalid_argument if the value does not fit.
+   SafeInteger checked(const BigInteger&);
+   /// Converts to the checked integer type. Throws std::invalid_argument if a value does not fit.
+   Row<SafeInteger> checked(const Row<BigInteger>&);
+   /// Converts to the checked integer type. Throws std::invalid_argument if a value does not fit.
+   Matrix<SafeInteger> checked(const Matrix<BigInteger>&);
+   /// Converts to the arbitrary precision integer type.
+   BigInteger arbitrary(const SafeInteger&);
+   /// Converts to the arbitrary precision integer type.
+   Matrix<BigInteger> arbitrary(const Matrix<SafeInteger>&);
+   /// Returns the converted input, or an empty matrix if it does not fit into the checked integer type.
+   Matrix<SafeInteger> checkedIfPossible(const Matrix<BigInteger>&);
+}
+
+panda::AdaptivePrecision::AdaptivePrecision(const Matrix<BigInteger>& input_, const std::size_t cache_limit)
+:
+   input(input_),
+   checked_input(checkedIfPossible(input_)),
+   cache(cache_limit),
+   job_count(0),
+   promotion_count(0)
+{
+}
+
+Matrix<BigInteger> panda::AdaptivePrecision::rotation(const Row<BigInteger>& job, const Maps& maps, tag::facet tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<BigInteger>* const arbitrary_cache)
+{
+   return adaptiveRotation(job, maps, tag, settings, for_each, arbitrary_cache);
+}
+
+Matrix<BigInteger> panda::AdaptivePrecision::rotation(const Row<BigInteger>& job, const Maps& maps, tag::vertex tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<BigInteger>* const arbitrary_cache)
+{
+   return adaptiveRotation(job, maps, tag, settings, for_each, arbitrary_cache);
+}
+
+std::size_t panda::AdaptivePrecision::jobs() const noexcept
+{
+   return job_count;
+}
+
+std::size_t panda::AdaptivePrecision::promotions() const noexcept
+{
+   return promotion_count;
+}
+
+const RidgeCache<SafeInteger>& panda::AdaptivePrecision::ridgeCache() const noexcept
+{
+   return cache;
+}
+
+template <typename TagType>
+Matrix<BigInteger> panda::AdaptivePrecision::adaptiveRotation(const Row<BigInteger>& job, const Maps& maps, TagType tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<BigInteger>* const arbitrary_cache)
+{
+   ++job_count;
+   if ( !checked_input.empty() )
+   {
+      try
+      {
+         const auto checked_cache = (arbitrary_cache != nullptr) ? &cache : nullptr;
+         return arbitrary(algorithm::rotation(checked_input, checked(job), maps, tag, settings, for_each, checked_cache));
+      }
+      catch ( const std::invalid_argument& )
+      {
+         // unsafe operations are reported like this. Any other error occurs again with arbitrary precision.
+      }
+   }
+   ++promotion_count;
+   return algorithm::rotation(input, job, maps, tag, settings, for_each, arbitrary_cache);
+}
+
+namespace
+{
+   SafeInteger checked(const BigInteger& value)
+   {
+      const BigInteger base(digit_base);
+      const auto quotient = value / base;
+      const int32_t digit = static_cast<int>(value - quotient * base);
+      if ( quotient == 0 )
+      {
+         return SafeInteger(digit);
+      }
+      return checked(quotient) * SafeInteger(digit_base) + SafeInteger(digit);
+   }
+
+   Row<SafeInteger> checked(const Row<BigInteger>& row)
+   {
+      Row<SafeInteger> result;
+      result.reserve(row.size());
+      for ( const auto& value : row )
+      {
+         result.push_back(checked(value));
+      }
+      return result;
+   }
+
+   Matrix<SafeInteger> checked(const Matrix<BigInteger>& matrix)
+   {
+      Matrix<SafeInteger> result;
+      result.reserve(matrix.size());
+      for ( const auto& row : matrix )
+      {
+         result.push_back(checked(row));
+      }
+      return result;
+   }
+
+   BigInteger arbitrary(const SafeInteger& value)
+   {
+      const SafeInteger base(digit_base);
+      const auto quotient = value / base;
+      const int32_t digit = static_cast<int>(value - quotient * base);
+      if ( quotient == 0 )
+      {
+         return BigInteger(digit);
+      }
+      return arbitrary(quotient) * BigInteger(digit_base) + BigInteger(digit);
+   }
+
+   Matrix<BigInteger> arbitrary(const Matrix<SafeInteger>& matrix)
+   {
+      Matrix<BigInteger> result;
+      result.reserve(matrix.size());
+      for ( const auto& row : matrix )
+      {
+         Row<BigInteger> converted;
+         converted.reserve(row.size());
+         for ( const auto& value : row )
+         {
+            converted.push_back(arbitrary(value));
+         }
+         result.push_back(std::move(converted));
+      }
+      return result;
+   }
+
+   Matrix<SafeInteger> checkedIfPossible(const Matrix<BigInteger>& matrix)
+   {
+      try
+      {
+         return checked(matrix);
+      }
+      catch ( const std::invalid_argument& )
+      {
+         return Matrix<SafeInteger>();
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,57 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "adjacency_decomposition_settings.h"
+#include "algorithm_rotation.h"
+#include "big_integer.h"
+#include "maps.h"
+#include "matrix.h"
+#include "ridge_cache.h"
+#include "row.h"
+#include "safe_integer.h"
+#include "tags.h"
+
+namespace panda
+{
+   /// Adjacency decomposition with adaptive precision: all rows are kept with arbitrary precision, but each job is
+   /// computed with the checked 64bit integer type first. Only jobs in which an operation overflows are computed again.
+   class AdaptivePrecision
+   {
+      public:
+         /// Constructor taking the input of the adjacency decomposition, which has to outlive the object,
+         /// and the size limit of the ridge cache of the checked integer type in bytes (zero means no limit).
+         AdaptivePrecision(const Matrix<BigInteger>&, const std::size_t);
+         /// Returns all adjacent rows of a job like algorithm::rotation. The given cache is used for repeated jobs.
+         Matrix<BigInteger> rotation(const Row<BigInteger>&, const Maps&, tag::facet, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<BigInteger>*);
+         /// Returns all adjacent rows of a job like algorithm::rotation. The given cache is used for repeated jobs.
+         Matrix<BigInteger> rotation(const Row<BigInteger>&, const Maps&, tag::vertex, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<BigInteger>*);
+         /// Number of jobs computed.
+         std::size_t jobs() const noexcept;
+         /// Number of jobs that were computed again with arbitrary precision.
+         std::size_t promotions() const noexcept;
+         /// Cache of the ridges computed with the checked integer type, in use if a cache is given to rotation.
+         const RidgeCache<SafeInteger>& ridgeCache() const noexcept;
+         /// Copy construction is not allowed.
+         AdaptivePrecision(const AdaptivePrecision&) = delete;
+         /// Copy assignment is not allowed.
+         AdaptivePrecision& operator=(const AdaptivePrecision&) = delete;
+      private:
+         const Matrix<BigInteger>& input;
+         Matrix<SafeInteger> checked_input; // empty if the input does not fit.
+         RidgeCache<SafeInteger> cache;
+         std::atomic<std::size_t> job_count;
+         std::atomic<std::size_t> promotion_count;
+      private:
+         /// Implementation of rotation for both tags.
+         template <typename TagType>
+         Matrix<BigInteger> adaptiveRotation(const Row<BigInteger>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<BigInteger>*);
+   };
+}
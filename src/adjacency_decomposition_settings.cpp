@@ -0,0 +1,114 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "adjacency_decomposition_settings.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "concurrency.h"
+#include "integer_type_detection.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Reads the incidence threshold of recursive adjacency decomposition from the command line.
+   std::size_t recursionThreshold(int, char**);
+   /// Reads the size limit of the ridge cache in bytes from the command line. Returns zero if the cache is not used.
+   std::size_t ridgeCacheLimit(int, char**);
+}
+
+panda::AdjacencyDecompositionSettings::AdjacencyDecompositionSettings() noexcept
+:
+   thread_count(1),
+   recursion_threshold(0),
+   ridge_cache(false),
+   ridge_cache_limit(std::size_t(1) << 30),
+   adaptive_precision(false)
+{
+}
+
+AdjacencyDecompositionSettings panda::adjacencyDecompositionSettings(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   AdjacencyDecompositionSettings settings;
+   settings.thread_count = static_cast<std::size_t>(concurrency::numberOfThreads(argc, argv));
+   settings.recursion_threshold = recursionThreshold(argc, argv);
+   const auto ridge_cache_limit = ridgeCacheLimit(argc, argv);
+   settings.ridge_cache = ( ridge_cache_limit > 0 );
+   if ( settings.ridge_cache )
+   {
+      settings.ridge_cache_limit = ridge_cache_limit;
+   }
+   settings.adaptive_precision = (integerType(argc, argv) == IntegerType::Adaptive);
+   return settings;
+}
+
+namespace
+{
+   std::size_t recursionThreshold(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--recursion-threshold=", 22) == 0 )
+         {
+            const auto argument = argv[i] + 22;
+            char* end = nullptr;
+            const auto value = std::strtoull(argument, &end, 10);
+            if ( end == argument || *end != '\0' || *argument == '-' )
+            {
+               throw std::invalid_argument("Command line option \"--recursion-threshold=<n>\" needs a non-negative number of vertices.");
+            }
+            return static_cast<std::size_t>(value);
+         }
+      }
+      return 0;
+   }
+
+   std::size_t ridgeCacheLimit(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strcmp(argv[i], "--ridge-cache") == 0 )
+         {
+            return AdjacencyDecompositionSettings().ridge_cache_limit;
+         }
+         if ( std::strncmp(argv[i], "--ridge-cache=", 14) == 0 )
+         {
+            const auto argument = argv[i] + 14;
+            char* end = nullptr;
+            const auto value = std::strtoull(argument, &end, 10);
+            std::size_t unit = 1;
+            if ( end != argument && *end != '\0' && end[1] == '\0' )
+            {
+               switch ( *end )
+               {
+                  case 'K':
+                     unit = std::size_t(1) << 10;
+                     ++end;
+                     break;
+                  case 'M':
+                     unit = std::size_t(1) << 20;
+                     ++end;
+                     break;
+                  case 'G':
+                     unit = std::size_t(1) << 30;
+                     ++end;
+                     break;
+               }
+            }
+            if ( end == argument || *end != '\0' || *argument == '-' || value == 0 )
+            {
+               throw std::invalid_argument("Command line option \"--ridge-cache=<n>\" needs a positive number of bytes, optionally followed by K, M or G.");
+            }
+            return static_cast<std::size_t>(value) * unit;
+         }
+      }
+      return 0;
+   }
+}
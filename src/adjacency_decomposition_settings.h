@@ -0,0 +1,30 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+
+namespace panda
+{
+   /// Parameters steering the adjacency decomposition.
+   struct AdjacencyDecompositionSettings
+   {
+      /// Default constructor: sequential, ridges are always computed by Fourier-Motzkin elimination.
+      AdjacencyDecompositionSettings() noexcept;
+      /// Number of threads working on jobs.
+      std::size_t thread_count;
+      /// Facets with more incident vertices get their ridges by adjacency decomposition again. Zero means no recursion.
+      std::size_t recursion_threshold;
+      /// Whether ridges are reused for facets whose vertices are equal up to a permutation of the coordinates.
+      bool ridge_cache;
+      /// Bytes the entries of the ridge cache may occupy, the least recently used ones are evicted beyond.
+      std::size_t ridge_cache_limit;
+      /// Whether jobs are computed with checked 64bit integers first and only repeated with arbitrary precision on overflow.
+      bool adaptive_precision;
+   };
+   /// Collects the adjacency decomposition settings from the command line.
+   AdjacencyDecompositionSettings adjacencyDecompositionSettings(int, char**);
+}
@@ -17,9 +17,17 @@
 
 #include "algorithm_map_operations.h"
 #include "algorithm_row_operations.h"
+#include "parallel_for.h"
 
 using namespace panda;
 
+namespace
+{
+   /// Generates the class of a row like getClass, but returns an empty set as soon as a generated row satisfies the predicate.
+   template <typename Integer, typename TagType, typename Predicate>
+   std::set<Row<Integer>> getClassUnless(const Row<Integer>&, const Maps&, TagType, const Predicate&);
+}
+
 template <typename Integer, typename TagType>
 Row<Integer> panda::algorithm::classRepresentative(const Row<Integer>& row, const Maps& maps, TagType tag)
 {
@@ -33,55 +41,105 @@ template <typename Integer, typename TagType>
 std::set<Row<Integer>> panda::algorithm::getClass(const Row<Integer>& row, const Maps& maps, TagType tag)
 {
    assert( !row.empty() );
-   std::set<Row<Integer>> rows;
-   rows.insert(row);
-   using Iterator = typename std::set<Row<Integer>>::iterator;
-   std::vector<Iterator> iterators;
-   iterators.push_back(rows.begin());
-   while ( !iterators.empty() )
-   {
-      const auto& current_row = *iterators.back();
-      iterators.pop_back();
-      for ( const auto& map : maps )
-      {
-         const auto new_row = apply(map, current_row, tag);
-         Iterator iterator;
-         bool inserted;
-         std::tie(iterator, inserted) = rows.insert(new_row);
-         if ( inserted )
-         {
-            iterators.push_back(iterator);
-         }
-      }
-   }
-   return rows;
+   return getClassUnless(row, maps, tag, [](const Row<Integer>&) { return false; });
+}
+
+template <typename Integer, typename TagType>
+bool panda::algorithm::isClassRepresentative(const Row<Integer>& row, const Maps& maps, TagType tag)
+{
+   assert( !row.empty() );
+   return !getClassUnless(row, maps, tag, [&row](const Row<Integer>& new_row) { return row < new_row; }).empty();
 }
 
 template <typename Integer, typename TagType>
 Matrix<Integer> panda::algorithm::classes(Matrix<Integer> input, const Maps& maps, TagType tag)
+{
+   return classes(std::move(input), maps, tag, 1);
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::algorithm::classes(Matrix<Integer> input, const Maps& maps, TagType tag, const std::size_t thread_count)
 {
    std::set<Row<Integer>> rows(input.cbegin(), input.cend());
-   return classes(rows, maps, tag);
+   input.clear();
+   return classes(std::move(rows), maps, tag, thread_count);
 }
 
 template <typename Integer, typename TagType>
 Matrix<Integer> panda::algorithm::classes(std::set<Row<Integer>> rows, const Maps& maps, TagType tag)
 {
-   Matrix<Integer> classes;
-   while ( !rows.empty() )
+   return classes(std::move(rows), maps, tag, 1);
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::algorithm::classes(std::set<Row<Integer>> rows, const Maps& maps, TagType tag, const std::size_t thread_count)
+{
+   // Taking the first remaining row and erasing its class until no row remains keeps exactly the rows
+   // that are the first of their class in the set. Each row checks this on its own, the set is only read.
+   using Iterator = typename std::set<Row<Integer>>::const_iterator;
+   std::vector<Iterator> iterators;
+   iterators.reserve(rows.size());
+   for ( auto it = rows.cbegin(); it != rows.cend(); ++it )
    {
-      const auto row_class = getClass(*rows.begin(), maps, tag);
-      assert( !row_class.empty() );
-      classes.push_back(*row_class.crbegin()); // Important detail: last element is chosen as the representative
-      for ( const auto& row : row_class )
+      iterators.push_back(it);
+   }
+   std::vector<Row<Integer>> representatives(iterators.size());
+   parallelFor(iterators.size(), thread_count, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+   {
+      for ( auto i = begin; i < end; ++i )
       {
-         const auto position = rows.find(row);
-         if ( position != rows.end() )
+         const auto& row = *iterators[i];
+         const auto row_class = getClassUnless(row, maps, tag, [&](const Row<Integer>& new_row)
+         {
+            return new_row < row && rows.count(new_row) > 0;
+         });
+         if ( !row_class.empty() )
          {
-            rows.erase(position);
+            representatives[i] = *row_class.crbegin(); // Important detail: last element is chosen as the representative
          }
       }
+   });
+   Matrix<Integer> classes;
+   for ( auto& representative : representatives )
+   {
+      if ( !representative.empty() )
+      {
+         classes.push_back(std::move(representative));
+      }
    }
    return classes;
 }
 
+namespace
+{
+   template <typename Integer, typename TagType, typename Predicate>
+   std::set<Row<Integer>> getClassUnless(const Row<Integer>& row, const Maps& maps, TagType tag, const Predicate& predicate)
+   {
+      std::set<Row<Integer>> rows;
+      rows.insert(row);
+      using Iterator = typename std::set<Row<Integer>>::iterator;
+      std::vector<Iterator> iterators;
+      iterators.push_back(rows.begin());
+      while ( !iterators.empty() )
+      {
+         const auto& current_row = *iterators.back();
+         iterators.pop_back();
+         for ( const auto& map : maps )
+         {
+            auto new_row = algorithm::apply(map, current_row, tag);
+            if ( predicate(new_row) )
+            {
+               return std::set<Row<Integer>>();
+            }
+            Iterator iterator;
+            bool inserted;
+            std::tie(iterator, inserted) = rows.insert(std::move(new_row));
+            if ( inserted )
+            {
+               iterators.push_back(iterator);
+            }
+         }
+      }
+      return rows;
+   }
+}
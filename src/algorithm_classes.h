@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <set>
 
 #include "maps.h"
@@ -25,14 +26,28 @@ namespace panda
       /// Precondition: if input is a facet, the facet must be normalized.
       template <typename Integer, typename TagType>
       std::set<Row<Integer>> getClass(const Row<Integer>&, const Maps&, TagType);
+      /// Checks if the row is the representative of its class, i.e. equal to classRepresentative of the row.
+      /// The class is only generated until a greater row is found.
+      /// Precondition: if input is a facet, the facet must be normalized.
+      template <typename Integer, typename TagType>
+      bool isClassRepresentative(const Row<Integer>&, const Maps&, TagType);
       /// Reduces a list of rows to just the representatives.
       /// Precondition: if input are facets, then these facets must be normalized.
       template <typename Integer, typename TagType>
       Matrix<Integer> classes(Matrix<Integer>, const Maps&, TagType);
+      /// Reduces a list of rows to just the representatives as above, using the given number of threads.
+      /// Precondition: if input are facets, then these facets must be normalized.
+      template <typename Integer, typename TagType>
+      Matrix<Integer> classes(Matrix<Integer>, const Maps&, TagType, const std::size_t);
       /// Reduces a list of rows to just the representatives.
       /// Precondition: if input are facets, then these facets must be normalized.
       template <typename Integer, typename TagType>
       Matrix<Integer> classes(std::set<Row<Integer>>, const Maps&, TagType);
+      /// Reduces a set of rows to just the representatives as above, using the given number of threads.
+      /// The output does not depend on the number of threads.
+      /// Precondition: if input are facets, then these facets must be normalized.
+      template <typename Integer, typename TagType>
+      Matrix<Integer> classes(std::set<Row<Integer>>, const Maps&, TagType, const std::size_t);
    }
 }
 
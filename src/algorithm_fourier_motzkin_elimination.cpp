@@ -10,17 +10,25 @@
 
 #include <algorithm>
 #include <cassert>
-#include <forward_list>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
+#include "algorithm_classes.h"
 #include "algorithm_matrix_operations.h"
 #include "algorithm_row_operations.h"
 #include "bitset_fixed_size.h"
+#include "bitset_sparse.h"
 #include "bitset_variable_size.h"
-#include "delayed_action.h"
-#include "range.h"
+#include "dense_matrix.h"
+#include "fourier_motzkin_phase_two.h"
+#include "parallel_for.h"
 
 using namespace panda;
 
@@ -29,90 +37,124 @@ namespace
    using Index = std::size_t;
    using Indices = std::vector<Index>;
    using ColumnIndex = std::size_t;
-   /// Chooses the correct Bitset type.
+   /// Full elimination up to the reinsertion of zero columns. Returns the final system and the zero columns.
    template <typename Integer>
-   void phaseTwoDispatch(Matrix<Integer>&, const Vertices<Integer>&);
-   /// The actual FME, named phase Two in Christof.
-   template <typename Bitset, typename Integer>
-   void phaseTwo(Matrix<Integer>&, const Vertices<Integer>&);
-   /// Abortable phase Two.
-   template <typename Bitset, typename Integer>
-   void phaseTwoHeuristic(Matrix<Integer>&, const Vertices<Integer>&);
-   /// Identifies indices of positive, zero and negative entries.
+   std::pair<DenseMatrix<Integer>, std::vector<ColumnIndex>> eliminate(Matrix<Integer>, const FourierMotzkinSettings&);
+   /// Chooses the correct Bitset type. The vertices before the given index are already inserted into the system.
    template <typename Integer>
-   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>&);
-   /// Identifies indices of positive, zero and negative entries.
-   template <typename Integer, typename Bitset>
-   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>&, const std::vector<Bitset>&, const std::size_t);
-   /// Replaces the system of matrix and indices.
-   template <typename Bitset, typename Integer>
-   std::pair<Matrix<Integer>, std::vector<Bitset>> updateSystem(
-      const Matrix<Integer>&,
-      const std::vector<Bitset>&,
-      const Index,
-      const std::tuple<Indices, Indices, Indices>&,
-      const Row<Integer>&,
-      const std::forward_list<std::tuple<Index, Index, Bitset>>&);
-   /// Checks minimality of the new system.
-   template <typename Bitset>
-   bool isMinimal(const Bitset&, const std::forward_list<std::tuple<Index, Index, Bitset>>&, const std::size_t);
+   void phaseTwoDispatch(DenseMatrix<Integer>&, Vertices<Integer>&, const FourierMotzkinSettings&, const std::size_t, const FourierMotzkinStepObserver& = FourierMotzkinStepObserver());
+   /// Phase 2 of the portfolio order: several insertion orders run concurrently, the system of the first to finish is kept.
+   /// The vertices before the given index are already inserted into the system.
+   template <typename Integer>
+   void phaseTwoPortfolio(DenseMatrix<Integer>&, Vertices<Integer>&, const FourierMotzkinSettings&, const std::size_t);
+   /// Brings the vertices from the given index on into a static insertion order.
+   template <typename Integer>
+   void orderVertices(Vertices<Integer>&, const Index, const InputOrder);
+   /// Name of an insertion order as given on the command line.
+   const char* inputOrderName(const InputOrder) noexcept;
+   /// Shared state of the concurrent runs of the portfolio order.
+   class PortfolioMonitor;
    /// After extraction of equations, zero columns remain that can be removed to reduce memory usage.
    template <typename Integer>
-   std::vector<ColumnIndex> eliminateZeroColumns(Matrix<Integer>&, Vertices<Integer>&);
+   std::vector<ColumnIndex> eliminateZeroColumns(DenseMatrix<Integer>&, Vertices<Integer>&);
    /// After phase 2, zero columns need to be reinserted.
    template <typename Integer>
-   void reinsertZeroColumns(Matrix<Integer>&, const std::vector<ColumnIndex>&);
-   /// Initialization of bitsets in phase 2.
-   template <typename Bitset, typename Integer>
-   std::vector<Bitset> initializeR(const Matrix<Integer>&, const Vertices<Integer>&);
-   /// Elimination of one ray.
-   template <typename Bitset, typename Integer>
-   void projection(Matrix<Integer>&, std::vector<Bitset>&, const Vertex<Integer>&, const Index);
+   Matrix<Integer> reinsertZeroColumns(const DenseMatrix<Integer>&, const std::vector<ColumnIndex>&);
+   /// Reinserts the zero columns into a single row of the given number of columns.
+   template <typename Integer>
+   Row<Integer> reinsertZeroColumns(const Integer*, const std::size_t, const std::vector<ColumnIndex>&);
+   /// After phase 2, zero columns are reinserted only into the rows representing their class.
+   /// The rows are tested in batches, the representatives of each batch are passed to the output in order.
+   template <typename Integer, typename TagType>
+   void representatives(const DenseMatrix<Integer>&, const std::vector<ColumnIndex>&, const Maps&, TagType, const std::size_t, const std::function<void(const Matrix<Integer>&)>&);
 }
 
 template <typename Integer>
 Matrix<Integer> panda::algorithm::fourierMotzkinElimination(Matrix<Integer> input)
+{
+   return fourierMotzkinElimination(std::move(input), FourierMotzkinSettings());
+}
+
+template <typename Integer>
+Matrix<Integer> panda::algorithm::fourierMotzkinElimination(Matrix<Integer> input, const FourierMotzkinSettings& settings)
+{
+   const auto system = eliminate(std::move(input), settings);
+   return reinsertZeroColumns(system.first, system.second);
+}
+
+template <typename Integer, typename TagType>
+void panda::algorithm::fourierMotzkinElimination(Matrix<Integer> input, const FourierMotzkinSettings& settings, const Maps& maps, TagType tag, const std::function<void(const Matrix<Integer>&)>& output)
+{
+   const auto system = eliminate(std::move(input), settings);
+   representatives(system.first, system.second, maps, tag, settings.thread_count, output);
+}
+
+template <typename Integer>
+Matrix<Integer> panda::algorithm::fourierMotzkinEliminationIncremental(Matrix<Integer> input, const Matrix<Integer>& facets, const FourierMotzkinSettings& settings)
 {
    assert( !input.empty() );
-   auto matrix = input;
-   appendNegativeIdentityMatrix(matrix);
-   Indices used_indices;
-   Indices equation_indices;
-   std::tie(equation_indices, used_indices) = gaussianElimination(matrix);
-   matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(input.size()));
-   assert( !matrix.empty() );
-   assert( matrix.size() == matrix.back().size() );
-   matrix = transpose(matrix);
-   std::sort(equation_indices.rbegin(), equation_indices.rend());
-   const auto equations = extractEquations(matrix, equation_indices);
-   const auto zero_columns = eliminateZeroColumns(matrix, input);
-   assert( std::is_sorted(used_indices.cbegin(), used_indices.cend()) );
-   Vertices<Integer> used;
-   used.reserve(used_indices.size());
-   for ( auto it = used_indices.crbegin(); it != used_indices.crend(); ++it )
+   if ( facets.empty() )
    {
-      used.push_back(input[*it]);
-      input.erase(input.begin() + static_cast<typename Matrix<Integer>::difference_type>(*it));
+      throw std::invalid_argument("Incremental Fourier-Motzkin elimination needs the facets of a previous result.");
    }
-   input.insert(input.begin(), used.cbegin(), used.cend());
-   phaseTwoDispatch(matrix, input);
-   reinsertZeroColumns(matrix, zero_columns);
-   return matrix;
+   const auto d = input.front().size();
+   // vertices valid for all facets lie in the previous polytope, so the facets are those of their convex hull.
+   const auto first_new = std::stable_partition(input.begin(), input.end(), [&facets](const Vertex<Integer>& vertex)
+   {
+      return std::all_of(facets.cbegin(), facets.cend(), [&vertex](const Facet<Integer>& facet)
+      {
+         return facet * vertex <= 0;
+      });
+   });
+   const auto inserted = static_cast<std::size_t>(std::distance(input.begin(), first_new));
+   if ( inserted < d || dimension(Matrix<Integer>(input.begin(), first_new)) < d )
+   {
+      throw std::invalid_argument("Incremental Fourier-Motzkin elimination needs a full-dimensional previous polytope.");
+   }
+   // each inequality must be a facet of the previous polytope. Whether the facets are complete is not checked,
+   // as it takes a vertex enumeration of the facets, which costs as much as the previous run.
+   parallelFor(facets.size(), settings.thread_count, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+   {
+      for ( auto k = begin; k < end; ++k )
+      {
+         const auto& facet = facets[k];
+         Matrix<Integer> tight;
+         std::copy_if(input.begin(), first_new, std::back_inserter(tight), [&facet](const Vertex<Integer>& vertex)
+         {
+            return facet * vertex == 0;
+         });
+         if ( tight.size() + 1 < d || dimension(std::move(tight)) + 1 != d )
+         {
+            throw std::invalid_argument("Incremental Fourier-Motzkin elimination needs facets of the previous polytope, an inequality is not tight on d - 1 affinely independent previous vertices.");
+         }
+      }
+   });
+   std::cerr << "Incremental Fourier-Motzkin Elimination: " << input.size() - inserted << " of " << input.size() << " vertices are new.\n";
+   DenseMatrix<Integer> matrix(facets);
+   if ( settings.insertion_order == InputOrder::Portfolio )
+   {
+      phaseTwoPortfolio(matrix, input, settings, inserted);
+   }
+   else
+   {
+      phaseTwoDispatch(matrix, input, settings, inserted);
+   }
+   return matrix.toMatrix();
 }
 
 template <typename Integer>
 Matrix<Integer> panda::algorithm::fourierMotzkinEliminationHeuristic(Matrix<Integer> input)
 {
    assert( !input.empty() );
-   auto matrix = input;
+   DenseMatrix<Integer> matrix(input);
    appendNegativeIdentityMatrix(matrix);
    Indices used_indices;
    Indices equation_indices;
    std::tie(equation_indices, used_indices) = gaussianElimination(matrix);
-   matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(input.size()));
+   matrix.eraseRows(0, input.size());
    assert( !matrix.empty() );
-   assert( matrix.size() == matrix.back().size() );
-   matrix = transpose(matrix);
+   assert( matrix.rows() == matrix.columns() );
+   matrix = matrix.transposed();
    std::sort(equation_indices.rbegin(), equation_indices.rend());
    const auto equations = extractEquations(matrix, equation_indices);
    const auto zero_columns = eliminateZeroColumns(matrix, input);
@@ -125,13 +167,48 @@ Matrix<Integer> panda::algorithm::fourierMotzkinEliminationHeuristic(Matrix<Inte
       input.erase(input.begin() + static_cast<typename Matrix<Integer>::difference_type>(*it));
    }
    input.insert(input.begin(), used.cbegin(), used.cend());
-   phaseTwoHeuristic<BitsetVariableSize>(matrix, input);
-   reinsertZeroColumns(matrix, zero_columns);
-   return matrix;
+   algorithm::fourierMotzkinPhaseTwoHeuristic(matrix, input);
+   return reinsertZeroColumns(matrix, zero_columns);
 }
-
 namespace
 {
+   template <typename Integer>
+   std::pair<DenseMatrix<Integer>, std::vector<ColumnIndex>> eliminate(Matrix<Integer> input, const FourierMotzkinSettings& settings)
+   {
+      assert( !input.empty() );
+      DenseMatrix<Integer> matrix(input);
+      algorithm::appendNegativeIdentityMatrix(matrix);
+      Indices used_indices;
+      Indices equation_indices;
+      // the initial basis is small, with a ForEach it does not start threads of its own.
+      std::tie(equation_indices, used_indices) = algorithm::gaussianElimination(matrix, settings.for_each ? 1 : settings.thread_count);
+      matrix.eraseRows(0, input.size());
+      assert( !matrix.empty() );
+      assert( matrix.rows() == matrix.columns() );
+      matrix = matrix.transposed();
+      std::sort(equation_indices.rbegin(), equation_indices.rend());
+      const auto equations = algorithm::extractEquations(matrix, equation_indices);
+      const auto zero_columns = eliminateZeroColumns(matrix, input);
+      assert( std::is_sorted(used_indices.cbegin(), used_indices.cend()) );
+      Vertices<Integer> used;
+      used.reserve(used_indices.size());
+      for ( auto it = used_indices.crbegin(); it != used_indices.crend(); ++it )
+      {
+         used.push_back(input[*it]);
+         input.erase(input.begin() + static_cast<typename Matrix<Integer>::difference_type>(*it));
+      }
+      input.insert(input.begin(), used.cbegin(), used.cend());
+      if ( settings.insertion_order == InputOrder::Portfolio )
+      {
+         phaseTwoPortfolio(matrix, input, settings, matrix.columns());
+      }
+      else
+      {
+         phaseTwoDispatch(matrix, input, settings, matrix.columns());
+      }
+      return std::make_pair(std::move(matrix), zero_columns);
+   }
+
    /// Phase 2 of Fourier Motzkin Elimination needs an efficient encoding of sets.
    ///  A bitset is used for this encoding. However, bitsets with a dynamic number of
    ///  bits are less efficient than bitsets with a fixed maximum size.
@@ -140,343 +217,313 @@ namespace
 
    ///  As the stack size is limited, using fixed size bitsets is not scalable.
    ///  Hence, only for a small number of vertices, a fixed size bitset is used.
-   ///  For all other, a generalized, heap-based, bitset is used.
+   ///  For all other, a heap-based bitset is used which stores the few vertices a row is incident to,
+   ///  so that its size does not grow with the number of vertices.
 
-   /// This method automatically chooses the optimal bitset type and executes the phase 2.
+   /// Widths in words of the fixed size bitsets phase 2 is compiled for.
+   ///  The widths grow by at most a third, so that no more than a quarter of each bitset is wasted.
+   ///  Each width is instantiated in one of the translation units fourier_motzkin_phase_two_words_*.cpp.
+   ///  Beyond the largest width, BitsetSparse is used.
+   template <std::size_t... Sizes>
+   struct BitsetWidths
+   {
+   };
+   using FixedBitsetWidths = BitsetWidths<1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, 28, 32, 40, 48, 64, 80, 100>;
+
+   /// Phase 2 with its arguments bound, called with the chosen bitset type.
    template <typename Integer>
-   void phaseTwoDispatch(Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
+   struct PhaseTwo
    {
-      assert( !vertices.empty() );
-      static_assert(std::is_same<BitsetFixedSize<1u>::DataType, BitsetVariableSize::DataType>::value, "The datatypes of BitsetFixedSize and BitsetVariableSize do not match. This is crucial for the optimal choice of type.");
-      const auto bitset_size = 1 + (vertices.size() - 1) / std::numeric_limits<typename BitsetFixedSize<1u>::DataType>::digits;
-      if ( bitset_size <= 1u )
-      {
-         phaseTwo<BitsetFixedSize<1u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 2u )
-      {
-         phaseTwo<BitsetFixedSize<2u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 3u )
-      {
-         phaseTwo<BitsetFixedSize<3u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 4u )
-      {
-         phaseTwo<BitsetFixedSize<4u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 6u )
-      {
-         phaseTwo<BitsetFixedSize<6u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 8u )
-      {
-         phaseTwo<BitsetFixedSize<8u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 10u )
-      {
-         phaseTwo<BitsetFixedSize<10u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 12u )
-      {
-         phaseTwo<BitsetFixedSize<12u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 16u )
-      {
-         phaseTwo<BitsetFixedSize<16u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 20u )
-      {
-         phaseTwo<BitsetFixedSize<20u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 30u )
-      {
-         phaseTwo<BitsetFixedSize<30u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 40u )
-      {
-         phaseTwo<BitsetFixedSize<40u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 50u )
+      DenseMatrix<Integer>& matrix;
+      Vertices<Integer>& vertices;
+      const FourierMotzkinSettings& settings;
+      const std::size_t inserted;
+      const FourierMotzkinStepObserver& observer;
+      template <typename Bitset>
+      void run() const
       {
-         phaseTwo<BitsetFixedSize<50u>>(matrix, vertices);
+         algorithm::fourierMotzkinPhaseTwo<Bitset>(matrix, vertices, settings, inserted, observer);
       }
-      else if ( bitset_size <= 75u )
-      {
-         phaseTwo<BitsetFixedSize<75u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 100u )
-      {
-         phaseTwo<BitsetFixedSize<100u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 150u )
-      {
-         phaseTwo<BitsetFixedSize<150u>>(matrix, vertices);
-      }
-      else if ( bitset_size <= 200u )
+   };
+
+   template <typename Function>
+   void dispatchBitsetWidth(const std::size_t, const Function& function, BitsetWidths<>)
+   {
+      function.template run<BitsetSparse>();
+   }
+
+   /// Runs the function with the narrowest fixed size bitset of at least the given number of words.
+   template <typename Function, std::size_t Size, std::size_t... Sizes>
+   void dispatchBitsetWidth(const std::size_t words, const Function& function, BitsetWidths<Size, Sizes...>)
+   {
+      if ( words <= Size )
       {
-         phaseTwo<BitsetFixedSize<200u>>(matrix, vertices);
+         function.template run<BitsetFixedSize<Size>>();
       }
       else
       {
-         phaseTwo<BitsetVariableSize>(matrix, vertices);
+         dispatchBitsetWidth(words, function, BitsetWidths<Sizes...>());
       }
    }
 
+   /// This method automatically chooses the optimal bitset type and executes the phase 2.
    template <typename Integer>
-   Facets<Integer> extractFacets(const Matrix<Integer>& matrix, const Vertices<Integer>& vertices, const std::size_t start)
+   void phaseTwoDispatch(DenseMatrix<Integer>& matrix, Vertices<Integer>& vertices, const FourierMotzkinSettings& settings, const std::size_t inserted, const FourierMotzkinStepObserver& observer)
    {
-      const auto& vs = vertices;
-      Facets<Integer> facets;
-      for ( const auto& row : matrix )
-      {
-         if ( std::all_of(vs.cbegin() + static_cast<typename Vertices<Integer>::difference_type>(start), vs.cend(), [&row](const Row<Integer>& v) { return row * v <= 0; }) )
-         {
-            facets.push_back(row);
-         }
-      }
-      return facets;
+      assert( !vertices.empty() );
+      static_assert(std::is_same<BitsetFixedSize<1u>::DataType, BitsetVariableSize::DataType>::value, "The datatypes of BitsetFixedSize and BitsetVariableSize do not match. This is crucial for the optimal choice of type.");
+      const auto bitset_size = 1 + (vertices.size() - 1) / std::numeric_limits<typename BitsetFixedSize<1u>::DataType>::digits;
+      dispatchBitsetWidth(bitset_size, PhaseTwo<Integer>{matrix, vertices, settings, inserted, observer}, FixedBitsetWidths());
    }
 
-   template <typename Bitset>
-   bool countCheck(const Bitset& Rn, const Bitset& Rp, const std::size_t max_count, const std::size_t max)
+   const char* inputOrderName(const InputOrder order) noexcept
    {
-      return Bitset::unionCount(Rn, Rp, max) <= max_count;
+      switch ( order )
+      {
+         case InputOrder::NoSorting:
+            return "none";
+         case InputOrder::LexicographicAscending:
+            return "lex_asc";
+         case InputOrder::LexicographicDescending:
+            return "lex_desc";
+         case InputOrder::NonZeroEntriesAscending:
+            return "nz_asc";
+         case InputOrder::NonZeroEntriesDescending:
+            return "nz_desc";
+         case InputOrder::Reverse:
+            return "reverse";
+         case InputOrder::MinCutoff:
+            return "min-cutoff";
+         case InputOrder::MaxIntersection:
+            return "max-intersection";
+         case InputOrder::PredictedMin:
+            return "predicted-min";
+         case InputOrder::Portfolio:
+            break;
+      }
+      return "portfolio";
    }
 
-   template <typename Bitset>
-   bool containmentCheck(const Bitset& Rn, const Bitset& Rp, const std::size_t max, const std::vector<Bitset>& R, const Indices& indices_zero)
+   template <typename Integer>
+   void orderVertices(Vertices<Integer>& vertices, const Index first, const InputOrder order)
    {
-      return std::all_of(indices_zero.cbegin(), indices_zero.cend(), [&](const std::size_t index_z)
+      assert( first <= vertices.size() );
+      const auto begin = vertices.begin() + static_cast<typename Vertices<Integer>::difference_type>(first);
+      const auto nonZeroEntries = [](const Vertex<Integer>& vertex)
       {
-         return !Bitset::unionContains(Rn, Rp, R[index_z], max);
-      });
-   }
-
-   template <typename Bitset>
-   void pnrIteration(std::forward_list<std::tuple<Index, Index, Bitset>>& pnrs,
-                     const std::size_t index_n,
-                     const std::size_t index_p,
-                     const Bitset& u,
-                     const std::size_t max)
-   {
-      using Iterator = typename std::forward_list<std::tuple<Index, Index, Bitset>>::iterator;
-      std::vector<Iterator> removal;
-      for ( auto it = pnrs.begin(), bit = pnrs.before_begin(); it != pnrs.end(); ++it, ++bit )
+         return vertex.size() - static_cast<std::size_t>(std::count(vertex.cbegin(), vertex.cend(), Integer(0)));
+      };
+      switch ( order )
       {
-         const auto& Rpnr = std::get<2>(*it);
-         if ( u.contains(Rpnr, max) )
-         {
+         case InputOrder::LexicographicAscending:
+            std::sort(begin, vertices.end());
             return;
-         }
-         if ( Rpnr.contains(u, max) )
-         {
-            removal.push_back(bit);
-         }
-      }
-      for ( const auto& entry : makeReverseRange(removal) )
-      {
-         pnrs.erase_after(entry);
-      }
-      pnrs.push_front(std::make_tuple(index_n, index_p, u));
-   }
-
-   template <typename Bitset, typename Integer>
-   void projection(Matrix<Integer>& matrix, std::vector<Bitset>& R, const Vertex<Integer>& vertex, const Index index)
-   {
-      assert( !matrix.empty() );
-      const auto d = vertex.size();
-      assert( matrix.back().size() == d );
-      assert( index >= d );
-      const auto max_count = index + 2 - d;
-      auto s = matrix * vertex;
-      const auto indices = getIndicesNZP(s, R, index);
-      const auto& indices_negative = std::get<0>(indices);
-      const auto& indices_zero = std::get<1>(indices);
-      const auto& indices_positive = std::get<2>(indices);
-      std::forward_list<std::tuple<Index, Index, Bitset>> pnrs;
-      for ( const auto& index_n : indices_negative )
-      {
-         const auto& Rn = R[index_n];
-         for ( const auto& index_p : indices_positive )
+         case InputOrder::LexicographicDescending:
+            std::sort(begin, vertices.end(), [](const Vertex<Integer>& a, const Vertex<Integer>& b) { return b < a; });
+            return;
+         case InputOrder::NonZeroEntriesAscending:
+         case InputOrder::NonZeroEntriesDescending:
          {
-            const auto& Rp = R[index_p];
-            if ( countCheck(Rn, Rp, max_count, index) )
+            const auto ascending = (order == InputOrder::NonZeroEntriesAscending);
+            std::sort(begin, vertices.end(), [&](const Vertex<Integer>& a, const Vertex<Integer>& b)
             {
-               if ( containmentCheck(Rn, Rp, index, R, indices_zero) )
+               const auto entries_a = nonZeroEntries(a);
+               const auto entries_b = nonZeroEntries(b);
+               if ( entries_a != entries_b )
                {
-                  const auto u = Rn.merge(Rp, index);
-                  pnrIteration(pnrs, index_n, index_p, u, index);
+                  return ascending ? (entries_a < entries_b) : (entries_a > entries_b);
                }
-            }
+               return (a < b);
+            });
+            return;
          }
+         case InputOrder::Reverse:
+            std::reverse(begin, vertices.end());
+            return;
+         default:
+            return;
       }
-      std::tie(matrix, R) = updateSystem(matrix, R, index, indices, s, pnrs);
    }
 
-   template <typename Integer>
-   void detectBadRow(Matrix<Integer>& matrix)
+   class PortfolioMonitor
    {
-      for ( std::size_t j = 0; j < matrix.size(); ++j )
-      {
-         const auto& row = matrix[j];
-         bool possible = true;
-         for ( std::size_t k = 0; k + 1 < row.size() && possible; ++k )
-         {
-            possible = (row[k] == 0);
-         }
-         if ( possible && row.back() == -1 )
+      public:
+         explicit PortfolioMonitor(std::vector<std::string> names_)
+         :
+            mutex(),
+            names(std::move(names_)),
+            sizes(names.size()),
+            alive(names.size(), true),
+            winner(names.size())
          {
-            matrix.erase(matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(j));
          }
-      }
-   }
-
-   template <typename Bitset, typename Integer>
-   void phaseTwo(Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
-   {
-      assert( !matrix.empty() );
-      const auto d = matrix.back().size();
-      auto R = initializeR<Bitset>(matrix, vertices);
-      assert( d <= vertices.size() );
-      for ( std::size_t i = d; i < vertices.size(); ++i )
-      {
-         const auto& vertex = vertices[i];
-         auto action = makeDelayedAction([&]()
-         {
-            std::cerr << "Fourier-Motzkin Elimination step " << i + 1 << " / " << vertices.size() << ": " << matrix.size() << '\n';
-         }, std::chrono::seconds(2));
-         projection(matrix, R, vertex, i);
-      }
-      detectBadRow(matrix);
-   }
-
-   template <typename Bitset, typename Integer>
-   void phaseTwoHeuristic(Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
-   {
-      const auto d = matrix.size();
-      auto R = initializeR<Bitset>(matrix, vertices);
-      assert( d <= vertices.size() );
-      for ( std::size_t i = d; i < vertices.size(); ++i )
-      {
-         auto facets = extractFacets(matrix, vertices, i);
-         detectBadRow(facets);
-         if ( !facets.empty() )
+         /// Records the rows of a run after the step inserting the given vertex. Returns false if the run is to be stopped.
+         /// Only runs still alive stop others, so at least one run is always alive.
+         bool report(const std::size_t run, const Index index, const std::size_t rows)
          {
-            matrix = facets;
-            break;
+            std::lock_guard<std::mutex> lock(mutex);
+            if ( !alive[run] )
+            {
+               return false;
+            }
+            sizes[run].push_back(rows);
+            const auto step = sizes[run].size() - 1;
+            for ( std::size_t other = 0; other < names.size(); ++other )
+            {
+               if ( other == run || !alive[other] || sizes[other].size() <= step )
+               {
+                  continue;
+               }
+               const auto other_rows = sizes[other][step];
+               if ( dominates(rows, other_rows) )
+               {
+                  stop(other, index, other_rows, run, rows);
+               }
+               else if ( dominates(other_rows, rows) )
+               {
+                  stop(run, index, rows, other, other_rows);
+                  return false;
+               }
+            }
+            return true;
          }
-         projection(matrix, R, vertices[i], i);
-      }
-   }
-
-   template <typename Integer>
-   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>& s)
-   {
-      std::tuple<Indices, Indices, Indices> indices;
-      auto& indices_negative = std::get<0>(indices);
-      auto& indices_zero = std::get<1>(indices);
-      auto& indices_positive = std::get<2>(indices);
-      for ( std::size_t j = 0; j < s.size(); ++j )
-      {
-         if ( s[j] < 0 )
+         /// Checks if a run has finished, so runs not started yet are not needed anymore.
+         bool decided()
          {
-            indices_negative.push_back(j);
+            std::lock_guard<std::mutex> lock(mutex);
+            return winner != names.size();
          }
-         else if ( s[j] == 0 )
+         /// Called by a run leaving phase 2. Returns true if it is the winner, i.e. the first run to finish.
+         bool finish(const std::size_t run)
          {
-            indices_zero.push_back(j);
+            std::lock_guard<std::mutex> lock(mutex);
+            if ( !alive[run] || winner != names.size() )
+            {
+               return false;
+            }
+            winner = run;
+            std::fill(alive.begin(), alive.end(), false);
+            std::cerr << "Fourier-Motzkin Elimination portfolio: " << names[run] << " finished first.\n";
+            return true;
          }
-         else // ( s[j] > 0 )
+      private:
+         /// A system dominates another after the same step if it is clearly smaller.
+         /// Small systems are cheap to continue, so they never lead to a stop.
+         static bool dominates(const std::size_t rows, const std::size_t other_rows) noexcept
          {
-            indices_positive.push_back(j);
+            const std::size_t factor = 4;
+            const std::size_t minimum_rows = 1024;
+            return other_rows >= minimum_rows && other_rows > factor * rows;
          }
-      }
-      return indices;
-   }
-
-   template <typename Integer, typename Bitset>
-   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>& s, const std::vector<Bitset>& R, const std::size_t max)
-   {
-      auto indices = getIndicesNZP(s);
-      auto& indices_zero = std::get<1>(indices);
-      std::sort(indices_zero.begin(), indices_zero.end(), [&R, &max] (const Index& a, const Index& b) { return R[a].count(max) < R[b].count(max); });
-      return indices;
-   }
-
-   template <typename Bitset, typename Integer>
-   std::pair<Matrix<Integer>, std::vector<Bitset>> updateSystem(
-      const Matrix<Integer>& matrix,
-      const std::vector<Bitset>& R,
-      const Index i,
-      const std::tuple<Indices, Indices, Indices>& indices,
-      const Row<Integer>& s,
-      const std::forward_list<std::tuple<Index, Index, Bitset>>& pnrs)
-   {
-      const auto& indices_negative = std::get<0>(indices);
-      const auto& indices_zero = std::get<1>(indices);
-      Matrix<Integer> new_matrix;
-      std::vector<Bitset> new_R;
-      new_matrix.reserve(indices_negative.size() + indices_zero.size());
-      new_R.reserve(indices_negative.size() + indices_zero.size());
-      for ( const auto index_z : indices_zero )
-      {
-         new_matrix.push_back(matrix[index_z]);
-         new_R.push_back(R[index_z]);
-      }
-      for ( const auto index_n : indices_negative )
-      {
-         new_matrix.push_back(matrix[index_n]);
-         new_R.push_back(R[index_n]);
-         new_R.back().set(i);
-      }
-      for ( const auto& pnr : pnrs )
-      {
-         const auto& index_n = std::get<0>(pnr);
-         const auto& index_p = std::get<1>(pnr);
-         new_matrix.push_back(s[index_p] * matrix[index_n] - s[index_n] * matrix[index_p]);
-         const auto gcd_value = algorithm::gcd(new_matrix.back());
-         if ( gcd_value > 1 )
+         void stop(const std::size_t run, const Index index, const std::size_t rows, const std::size_t by, const std::size_t by_rows)
          {
-            new_matrix.back() /= gcd_value;
+            alive[run] = false;
+            std::cerr << "Fourier-Motzkin Elimination portfolio step " << index + 1 << ": stopped " << names[run] << " with " << rows << " rows, " << names[by] << " has " << by_rows << ".\n";
          }
-         new_R.push_back(std::get<2>(pnr));
-      }
-      return std::make_pair(new_matrix, new_R);
-   }
+         std::mutex mutex;
+         std::vector<std::string> names;
+         /// Rows after each step, per run.
+         std::vector<std::vector<std::size_t>> sizes;
+         std::vector<bool> alive;
+         std::size_t winner;
+   };
 
-   template <typename Bitset>
-   bool isMinimal(const Bitset& bitset, const std::forward_list<std::tuple<Index, Index, Bitset>>& pnrs, const std::size_t max)
+   template <typename Integer>
+   void phaseTwoPortfolio(DenseMatrix<Integer>& matrix, Vertices<Integer>& vertices, const FourierMotzkinSettings& settings, const std::size_t inserted)
    {
-      for ( const auto& pnr : pnrs )
-      {
-         const auto& Rpnr = std::get<2>(pnr);
-         if ( bitset.contains(Rpnr, max) )
+      if ( !settings.checkpoint_file.empty() || !settings.resume_file.empty() )
+      {
+         throw std::invalid_argument("The portfolio insertion order does not support checkpoints.");
+      }
+      const std::vector<InputOrder> orders =
+      {
+         InputOrder::NoSorting,
+         InputOrder::LexicographicAscending,
+         InputOrder::LexicographicDescending,
+         InputOrder::NonZeroEntriesAscending,
+         InputOrder::NonZeroEntriesDescending,
+         InputOrder::Reverse,
+         InputOrder::MinCutoff,
+         InputOrder::MaxIntersection,
+         InputOrder::PredictedMin
+      };
+      const unsigned random_runs = 3;
+      const auto run_count = orders.size() + random_runs;
+      std::vector<std::string> names;
+      for ( const auto order : orders )
+      {
+         names.push_back(inputOrderName(order));
+      }
+      for ( unsigned seed = 1; seed <= random_runs; ++seed )
+      {
+         names.push_back("random (seed " + std::to_string(seed) + ")");
+      }
+      // at most one run per thread is alive at a time, further runs start in order when a run ends.
+      // threads and memory are shared evenly among the runs alive at the same time.
+      const auto concurrent = std::min<std::size_t>(run_count, std::max<std::size_t>(1, settings.thread_count));
+      const auto threads_per_run = std::max<std::size_t>(1, settings.thread_count / concurrent);
+      const auto memory_per_run = (settings.memory_limit > 0) ? std::max<std::size_t>(1, settings.memory_limit / concurrent) : std::size_t(0);
+      std::cerr << "Fourier-Motzkin Elimination portfolio: " << run_count << " orders, " << concurrent << " at a time, " << threads_per_run << " thread(s) per order.\n";
+      PortfolioMonitor monitor(names);
+      DenseMatrix<Integer> winning_system;
+      // only the winner writes its index and system.
+      auto winner = run_count;
+      parallelFor(run_count, concurrent, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         for ( auto run = begin; run < end; ++run )
          {
-            return false;
+            if ( monitor.decided() )
+            {
+               return;
+            }
+            auto run_settings = settings;
+            run_settings.thread_count = threads_per_run;
+            run_settings.memory_limit = memory_per_run;
+            // each run copies the system when it starts, so only the runs alive hold a copy.
+            auto system = matrix;
+            auto run_vertices = vertices;
+            if ( run < orders.size() )
+            {
+               run_settings.insertion_order = orders[run];
+               orderVertices(run_vertices, inserted, orders[run]);
+            }
+            else
+            {
+               run_settings.insertion_order = InputOrder::NoSorting;
+               std::mt19937 generator(static_cast<std::mt19937::result_type>(run - orders.size() + 1));
+               std::shuffle(run_vertices.begin() + static_cast<typename Vertices<Integer>::difference_type>(inserted), run_vertices.end(), generator);
+            }
+            phaseTwoDispatch(system, run_vertices, run_settings, inserted, [&monitor, run](const std::size_t index, const std::size_t rows)
+            {
+               return monitor.report(run, index, rows);
+            });
+            if ( monitor.finish(run) )
+            {
+               winner = run;
+               winning_system = std::move(system);
+            }
          }
-      }
-      return true;
+      });
+      assert( winner < run_count );
+      matrix = std::move(winning_system);
    }
 
    template <typename Integer>
-   std::vector<ColumnIndex> eliminateZeroColumns(Matrix<Integer>& matrix, Vertices<Integer>& vertices)
+   std::vector<ColumnIndex> eliminateZeroColumns(DenseMatrix<Integer>& matrix, Vertices<Integer>& vertices)
    {
       Indices zero_columns;
-      for ( std::size_t col = matrix.back().size(); col > 0; )
+      for ( std::size_t col = matrix.columns(); col > 0; )
       {
          --col;
-         const auto all_zero = std::all_of(matrix.cbegin(), matrix.cend(), [&col](const Row<Integer>& row)
+         bool all_zero = true;
+         for ( std::size_t j = 0; j < matrix.rows() && all_zero; ++j )
          {
-            return (row[col] == 0);
-         });
+            all_zero = (matrix[j][col] == 0);
+         }
          if ( all_zero )
          {
             zero_columns.push_back(col);
-            for ( auto& row : matrix )
-            {
-               row.erase(row.begin() + static_cast<typename Row<Integer>::difference_type>(col));
-            }
+            matrix.eraseColumn(col);
             for ( auto& vertex : vertices )
             {
                vertex.erase(vertex.begin() + static_cast<typename Vertex<Integer>::difference_type>(col));
@@ -488,41 +535,73 @@ namespace
    }
 
    template <typename Integer>
-   void reinsertZeroColumns(Matrix<Integer>& matrix, const std::vector<ColumnIndex>& zero_columns)
+   Matrix<Integer> reinsertZeroColumns(const DenseMatrix<Integer>& matrix, const std::vector<ColumnIndex>& zero_columns)
    {
       assert( std::is_sorted(zero_columns.crbegin(), zero_columns.crend()) );
-      for ( const auto col : makeReverseRange(zero_columns) )
+      Matrix<Integer> result;
+      result.reserve(matrix.rows());
+      for ( std::size_t j = 0; j < matrix.rows(); ++j )
+      {
+         result.push_back(reinsertZeroColumns(matrix[j], matrix.columns(), zero_columns));
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   Row<Integer> reinsertZeroColumns(const Integer* row, const std::size_t columns, const std::vector<ColumnIndex>& zero_columns)
+   {
+      const auto d = columns + zero_columns.size();
+      Row<Integer> result(d, Integer(0));
+      auto zero = zero_columns.crbegin();
+      for ( std::size_t col = 0, k = 0; col < d; ++col )
       {
-         for ( auto& row : matrix )
+         if ( zero != zero_columns.crend() && *zero == col )
          {
-            row.insert(row.begin() + static_cast<const typename Row<Integer>::difference_type>(col), Integer(0));
+            ++zero;
+         }
+         else
+         {
+            result[col] = row[k];
+            ++k;
          }
       }
+      return result;
    }
 
-   template <typename Bitset, typename Integer>
-   std::vector<Bitset> initializeR(const Matrix<Integer>& matrix, const Vertices<Integer>& vertices)
+   template <typename Integer, typename TagType>
+   void representatives(const DenseMatrix<Integer>& matrix, const std::vector<ColumnIndex>& zero_columns, const Maps& maps, TagType tag, const std::size_t thread_count, const std::function<void(const Matrix<Integer>&)>& output)
    {
-      assert( !matrix.empty() );
-      assert( matrix.size() == matrix.back().size() );
-      assert( !vertices.empty() );
-      assert( matrix.back().size() == vertices.back().size() );
-      const auto d = matrix.size();
-      assert( d <= vertices.size() );
-      std::vector<Bitset> R(matrix.size(), Bitset(vertices.size()));
-      for ( std::size_t i = 0; i < matrix.size(); ++i )
-      {
-         const auto& row = matrix[i];
-         for ( std::size_t j = 0; j < d; ++j )
+      assert( std::is_sorted(zero_columns.crbegin(), zero_columns.crend()) );
+      // representatives of a batch are written while only the rows of the batch are held twice.
+      const auto batch_size = 1024 * std::max<std::size_t>(1, thread_count);
+      std::size_t count = 0;
+      for ( std::size_t first = 0; first < matrix.rows(); first += batch_size )
+      {
+         const auto size = std::min(batch_size, matrix.rows() - first);
+         // rows are tested independently, the chunks are concatenated in order.
+         std::vector<Matrix<Integer>> chunk_rows(chunkCount(size, thread_count));
+         parallelFor(size, thread_count, [&](const std::size_t chunk, const std::size_t begin, const std::size_t end)
          {
-            const auto& vertex = vertices[j];
-            if ( row * vertex < 0 )
+            for ( auto j = first + begin; j < first + end; ++j )
             {
-               R[i].set(j);
+               auto row = reinsertZeroColumns(matrix[j], matrix.columns(), zero_columns);
+               if ( algorithm::isClassRepresentative(row, maps, tag) )
+               {
+                  chunk_rows[chunk].push_back(std::move(row));
+               }
             }
+         });
+         Matrix<Integer> batch;
+         for ( auto& rows : chunk_rows )
+         {
+            std::move(rows.begin(), rows.end(), std::back_inserter(batch));
+         }
+         count += batch.size();
+         if ( !batch.empty() )
+         {
+            output(batch);
          }
       }
-      return R;
+      std::cerr << "Fourier-Motzkin Elimination: " << count << " of " << matrix.rows() << " rows represent their class.\n";
    }
 }
-
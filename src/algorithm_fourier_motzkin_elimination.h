@@ -7,11 +7,15 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <tuple>
 #include <vector>
 
+#include "fourier_motzkin_settings.h"
+#include "maps.h"
 #include "matrix.h"
 #include "row.h"
+#include "tags.h"
 
 namespace panda
 {
@@ -22,6 +26,23 @@ namespace panda
       /// extremal vertices/rays is returned.
       template <typename Integer>
       Matrix<Integer> fourierMotzkinElimination(Matrix<Integer>);
+      /// Full Fourier-Motzkin elimination as above, with explicit settings (e.g. the number of threads).
+      template <typename Integer>
+      Matrix<Integer> fourierMotzkinElimination(Matrix<Integer>, const FourierMotzkinSettings&);
+      /// Full Fourier-Motzkin elimination as above, passing one representative of each class of output rows to the output
+      /// batch by batch as they are found. The classes are generated by the maps, the representatives are the ones chosen
+      /// by classRepresentative. Rows of the final system are tested one by one, so the full output is never copied.
+      /// The batches follow the order of the final system, each batch is passed before the next one is tested.
+      template <typename Integer, typename TagType>
+      void fourierMotzkinElimination(Matrix<Integer>, const FourierMotzkinSettings&, const Maps&, TagType, const std::function<void(const Matrix<Integer>&)>&);
+      /// Fourier-Motzkin elimination continuing from the facets of a previous result.
+      /// Input vertices valid for all facets are considered inserted, the others are inserted one by one
+      /// in the insertion order of the settings. The incidences of the facets are recomputed from the vertices.
+      /// The previous polytope must be full-dimensional and the facets must be normalized like the output of fourierMotzkinElimination.
+      /// Throws std::invalid_argument if an inequality is not a facet of the previous polytope. The facets must be complete,
+      /// which is not checked: with a facet missing, the output is wrong.
+      template <typename Integer>
+      Matrix<Integer> fourierMotzkinEliminationIncremental(Matrix<Integer>, const Matrix<Integer>&, const FourierMotzkinSettings&);
       /// Heuristic using Fourier-Motzkin elimination to identify some facets.
       /// Output is guaranteed to contain only facets, but it is highly likely
       /// that it is not the complete set of facets.
@@ -11,10 +11,14 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <numeric>
 #include <tuple>
+#include <type_traits>
 
 #include "algorithm_integer_operations.h"
+#include "algorithm_modular_rank.h"
 #include "algorithm_row_operations.h"
+#include "parallel_for.h"
 
 using namespace panda;
 
@@ -69,69 +73,136 @@ namespace
 {
    using RowIndex = std::size_t;
    using ColumnIndex = std::size_t;
+   // The helpers work on the transposition (columns are stored contiguously), as the elimination adds columns.
+   /// Built-in integer types overflow silently. Their elimination steps divide each updated row or column by the gcd
+   /// of its entries instead of by the previous pivot (Bareiss), which keeps the entries small.
    template <typename Integer>
-   void eliminateColumns(Matrix<Integer>&, const RowIndex, const ColumnIndex);
+   constexpr bool stepwiseNormalization()
+   {
+      return std::is_integral<Integer>::value;
+   }
+   /// Divides the entries by their gcd if it is greater than one.
+   template <typename Integer>
+   void divideByGcd(Integer*, Integer*);
+   /// Fraction-free (Bareiss) step: eliminates the entries of all columns except col in the given row.
+   /// The entries stay minors of the input, so the division by the previous pivot is exact.
+   /// With stepwise normalization, previous is one, columns with a zero entry in the row are skipped
+   /// and each updated column is divided by its gcd.
    template <typename Integer>
-   std::pair<RowIndex, ColumnIndex> pivot(Matrix<Integer>&, std::size_t, std::vector<ColumnIndex>&);
+   void eliminateColumns(DenseMatrix<Integer>&, const RowIndex, const ColumnIndex, const Integer&, const std::size_t);
+   /// Searches the rows from the given one on for the first with a non-zero entry in an unused column.
+   /// Returns the row and the position of the column in the unused columns, or the number of rows if there is none.
+   template <typename Integer>
+   std::pair<RowIndex, std::size_t> pivot(const DenseMatrix<Integer>&, const RowIndex, const std::vector<ColumnIndex>&);
+   /// Divides each column by the gcd of its entries and makes its first non-zero entry positive.
+   template <typename Integer>
+   void normalizeColumns(DenseMatrix<Integer>&, const std::size_t);
 }
 
 template <typename Integer>
-std::size_t algorithm::dimension(Matrix<Integer> matrix)
+std::size_t algorithm::dimension(Matrix<Integer> input)
 {
-   assert( !matrix.empty() && !matrix.back().empty() );
-   std::vector<std::size_t> pivot_columns;
-   for ( std::size_t i = 0; i < matrix.size(); ++i )
+   assert( !input.empty() && !input.back().empty() );
+   // arbitrary precision and checked integers suffer from coefficient growth, the modular rank does not.
+   if ( !std::is_integral<Integer>::value )
    {
-      auto& row = matrix[i];
-      assert( i == pivot_columns.size() );
-      for ( std::size_t j = 0; j < i; ++j ) // use row j to eliminate coefficients in row i.
+      const auto modular = modularRank(input);
+      if ( modular.second )
       {
-         const auto piv_col = pivot_columns[j];
-         if ( row[piv_col] != 0 )
-         {
-            const auto factor = row[piv_col];
-            row *= Integer(-matrix[j][piv_col]); // Integer type name necessary because of integral promotion of short.
-            row += factor * matrix[j];
-            const auto gcd_value = gcd(row);
-            if ( gcd_value > 1 )
-            {
-               row /= gcd_value;
-            }
-         }
+         return modular.first;
       }
-      const auto nz_entry = std::find_if(row.cbegin(), row.cend(), [](const Integer& a) { return a != 0; });
-      if ( nz_entry == row.cend() )
+   }
+   // fraction-free forward elimination, the entries of the remaining rows stay minors of the input
+   // (or divisors of them with stepwise normalization).
+   DenseMatrix<Integer> matrix(input);
+   const auto row_size = matrix.rows();
+   const auto col_size = matrix.columns();
+   std::size_t rank = 0;
+   Integer previous(1);
+   for ( ColumnIndex col = 0; col < col_size && rank < row_size; ++col )
+   {
+      RowIndex row = rank;
+      while ( row < row_size && matrix[row][col] == 0 )
       {
-         matrix.erase(matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(i));
-         --i;
+         ++row;
       }
-      else
+      if ( row == row_size )
+      {
+         continue;
+      }
+      matrix.swapRows(row, rank);
+      const auto pivot_row = matrix[rank];
+      const Integer pivot_entry = pivot_row[col];
+      for ( row = rank + 1; row < row_size; ++row )
+      {
+         const auto entries = matrix[row];
+         const Integer factor = entries[col];
+         if ( stepwiseNormalization<Integer>() && factor == 0 )
+         {
+            continue;
+         }
+         for ( auto j = col + 1; j < col_size; ++j )
+         {
+            entries[j] = Integer((pivot_entry * entries[j] - factor * pivot_row[j]) / previous);
+         }
+         entries[col] = Integer(0);
+         if ( stepwiseNormalization<Integer>() )
+         {
+            divideByGcd(entries + col + 1, entries + col_size);
+         }
+      }
+      if ( !stepwiseNormalization<Integer>() )
       {
-         pivot_columns.push_back(static_cast<std::size_t>(nz_entry - row.cbegin()));
+         previous = pivot_entry;
       }
+      ++rank;
    }
-   return pivot_columns.size();
+   return rank;
 }
 
 template <typename Integer>
 std::pair<Indices, Indices> algorithm::gaussianElimination(Matrix<Integer>& matrix)
 {
    assert( !matrix.empty() && !matrix.back().empty() );
+   DenseMatrix<Integer> dense(matrix);
+   const auto indices = gaussianElimination(dense);
+   for ( RowIndex row = 0; row < matrix.size(); ++row )
+   {
+      std::copy(dense[row], dense[row] + dense.columns(), matrix[row].begin());
+   }
+   return indices;
+}
+
+template <typename Integer>
+std::pair<Indices, Indices> algorithm::gaussianElimination(DenseMatrix<Integer>& matrix)
+{
+   return gaussianElimination(matrix, 1);
+}
+
+template <typename Integer>
+std::pair<Indices, Indices> algorithm::gaussianElimination(DenseMatrix<Integer>& matrix, const std::size_t thread_count)
+{
+   assert( !matrix.empty() && matrix.columns() > 0 );
    Indices L;
    Indices T;
-   const auto row_size = matrix.size();
-   const auto col_size = matrix.back().size();
-   const auto t = matrix.size() - matrix.back().size();
-   std::vector<ColumnIndex> used_columns;
-   used_columns.reserve(col_size);
-   for ( RowIndex row = 0; row < row_size; ++row )
+   const auto row_size = matrix.rows();
+   const auto col_size = matrix.columns();
+   const auto t = row_size - col_size;
+   auto columns = matrix.transposed();
+   // columns not yet used as pivot, in ascending order.
+   std::vector<ColumnIndex> unused_columns(col_size);
+   std::iota(unused_columns.begin(), unused_columns.end(), ColumnIndex(0));
+   Integer previous(1);
+   for ( RowIndex row = 0; row < row_size && !unused_columns.empty(); ++row )
    {
-      std::size_t col;
-      std::tie(row, col) = pivot(matrix, row, used_columns);
+      std::size_t position;
+      std::tie(row, position) = pivot(columns, row, unused_columns);
       if ( row == row_size )
       {
          break;
       }
+      const auto col = unused_columns[position];
+      unused_columns.erase(unused_columns.begin() + static_cast<std::vector<ColumnIndex>::difference_type>(position));
       if ( row >= t )
       {
          L.push_back(col);
@@ -140,21 +211,14 @@ std::pair<Indices, Indices> algorithm::gaussianElimination(Matrix<Integer>& matr
       {
          T.push_back(row);
       }
-      eliminateColumns(matrix, row, col);
-   }
-   for ( ColumnIndex col = 0; col < col_size; ++col )
-   {
-      using Type = Row<Integer>;
-      const auto& m = matrix;
-      const auto& pivot_row = *std::find_if(m.cbegin(), m.cend(), [col](const Type& row) { return row[col] != 0; });
-      if ( pivot_row[col] < 0 )
+      eliminateColumns(columns, row, col, previous, thread_count);
+      if ( !stepwiseNormalization<Integer>() )
       {
-         for ( RowIndex row = 0; row < row_size; ++row )
-         {
-            matrix[row][col] *= Integer(-1);
-         }
+         previous = columns[col][row];
       }
    }
+   normalizeColumns(columns, thread_count);
+   matrix = columns.transposed();
    return std::make_pair(L, T);
 }
 
@@ -172,17 +236,36 @@ void algorithm::appendNegativeIdentityMatrix(Matrix<Integer>& matrix)
 }
 
 template <typename Integer>
-Equations<Integer> algorithm::extractEquations(Matrix<Integer> matrix)
+void algorithm::appendNegativeIdentityMatrix(DenseMatrix<Integer>& matrix)
 {
    assert( !matrix.empty() );
-   const auto original_size = matrix.size();
+   const auto dim = matrix.columns();
+   const auto offset = matrix.rows();
+   matrix.resizeRows(offset + dim);
+   for ( std::size_t i = 0; i < dim; ++i )
+   {
+      matrix[offset + i][i] = Integer(-1);
+   }
+}
+
+template <typename Integer>
+Equations<Integer> algorithm::extractEquations(Matrix<Integer> vertices)
+{
+   assert( !vertices.empty() );
+   // a full-dimensional set has no equations. Its modular rank is confirmed without exact elimination.
+   if ( !std::is_integral<Integer>::value && modularRank(vertices).first == vertices.front().size() )
+   {
+      return Equations<Integer>();
+   }
+   DenseMatrix<Integer> matrix(vertices);
+   const auto original_size = matrix.rows();
    appendNegativeIdentityMatrix(matrix);
    Indices used_indices;
    Indices equation_indices;
    std::tie(equation_indices, used_indices) = gaussianElimination(matrix);
-   matrix.erase(matrix.begin(), matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(original_size));
-   assert( !matrix.empty() && matrix.size() == matrix.back().size() );
-   matrix = transpose(matrix);
+   matrix.eraseRows(0, original_size);
+   assert( !matrix.empty() && matrix.rows() == matrix.columns() );
+   matrix = matrix.transposed();
    std::sort(equation_indices.rbegin(), equation_indices.rend());
    return extractEquations(matrix, equation_indices);
 }
@@ -201,87 +284,127 @@ Equations<Integer> algorithm::extractEquations(Matrix<Integer>& matrix, const In
    return equations;
 }
 
+template <typename Integer>
+Equations<Integer> algorithm::extractEquations(DenseMatrix<Integer>& matrix, const Indices& indices)
+{
+   assert( !matrix.empty() );
+   assert( std::is_sorted(indices.crbegin(), indices.crend()) );
+   const auto row_size = matrix.rows();
+   Equations<Integer> equations;
+   equations.reserve(indices.size());
+   for ( std::size_t i = 0; i < indices.size(); ++i )
+   {
+      matrix.swapRows(indices[i], row_size - 1 - i);
+      equations.push_back(matrix.row(row_size - 1 - i));
+   }
+   matrix.eraseRows(row_size - indices.size(), row_size);
+   return equations;
+}
+
 namespace
 {
    template <typename Integer>
-   void normalizeColumn(Matrix<Integer>& matrix, const ColumnIndex column)
+   void eliminateColumns(DenseMatrix<Integer>& columns, const RowIndex row, const ColumnIndex col, const Integer& previous, const std::size_t thread_count)
    {
-      const auto row_size = matrix.size();
-      Integer gcd_val(0);
-      for ( RowIndex j = 0; j < row_size; ++j )
-      {
-         gcd_val = algorithm::gcd(gcd_val, matrix[j][column]);
-      }
-      if ( gcd_val > 1 )
+      assert( !columns.empty() );
+      assert( row < columns.columns() );
+      assert( col < columns.rows() );
+      const auto row_size = columns.columns();
+      const auto pivot_entries = columns[col];
+      const Integer a = pivot_entries[row];
+      // all columns are scaled, even those with a zero entry in the pivot row, to keep the divisions exact.
+      parallelFor(columns.rows(), thread_count, [&](const std::size_t, const std::size_t begin, const std::size_t end)
       {
-         for ( RowIndex j = 0; j < row_size; ++j )
+         for ( auto i = begin; i < end; ++i )
          {
-            matrix[j][column] /= gcd_val;
+            if ( i == col )
+            {
+               continue;
+            }
+            const auto entries = columns[i];
+            const Integer b = entries[row];
+            if ( stepwiseNormalization<Integer>() && b == 0 )
+            {
+               continue;
+            }
+            for ( RowIndex j = 0; j < row_size; ++j )
+            {
+               entries[j] = Integer((a * entries[j] - b * pivot_entries[j]) / previous);
+            }
+            if ( stepwiseNormalization<Integer>() )
+            {
+               divideByGcd(entries, entries + row_size);
+            }
          }
-      }
+      });
    }
 
    template <typename Integer>
-   void eliminateColumn(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col, const ColumnIndex ecol)
+   void divideByGcd(Integer* first, Integer* last)
    {
-      const auto row_size = matrix.size();
-      const auto a = -matrix[row][col];
-      const auto b =  matrix[row][ecol];
-      for ( RowIndex j = 0; j < row_size; ++j )
+      Integer gcd_val(0);
+      for ( auto it = first; it != last; ++it )
       {
-         matrix[j][ecol] *= a;
-         matrix[j][ecol] += (matrix[j][col] * b);
+         gcd_val = algorithm::gcd(gcd_val, *it);
+      }
+      if ( gcd_val > 1 )
+      {
+         for ( auto it = first; it != last; ++it )
+         {
+            *it /= gcd_val;
+         }
       }
    }
 
-   /// Eliminate all entries in column col except row to 0, by adding rows (using row "row").
    template <typename Integer>
-   void eliminateColumns(Matrix<Integer>& matrix, const RowIndex row, const ColumnIndex col)
+   std::pair<RowIndex, std::size_t> pivot(const DenseMatrix<Integer>& columns, RowIndex row, const std::vector<ColumnIndex>& unused_columns)
    {
-      assert( !matrix.empty() );
-      assert( row < matrix.size() );
-      assert( col < matrix.back().size() );
-      const auto col_size = matrix.back().size();
-      for ( ColumnIndex i = 0; i < col_size; ++i )
+      assert( !columns.empty() );
+      const auto row_size = columns.columns();
+      for ( ; row < row_size; ++row )
       {
-         const auto b = matrix[row][i];
-         if ( i != col && b != 0 )
+         for ( std::size_t position = 0; position < unused_columns.size(); ++position )
          {
-            eliminateColumn(matrix, row, col, i);
-            normalizeColumn(matrix, i);
+            if ( columns[unused_columns[position]][row] != 0 )
+            {
+               return std::make_pair(row, position);
+            }
          }
       }
+      return std::make_pair(row_size, unused_columns.size());
    }
 
-   /// Search row-wise to get the first (row, col) with matrix[row][col] != 0.
    template <typename Integer>
-   std::pair<RowIndex, ColumnIndex> pivot(Matrix<Integer>& matrix,
-                                          std::size_t iteration,
-                                          std::vector<ColumnIndex>& used_columns)
+   void normalizeColumns(DenseMatrix<Integer>& columns, const std::size_t thread_count)
    {
-      assert( !matrix.empty() );
-      assert( iteration < matrix.size() );
-      const auto row_size = matrix.size();
-      const auto col_size = matrix.back().size();
-      ColumnIndex row = iteration;
-      ColumnIndex col = col_size;
-      for ( ; row < row_size; ++row )
+      const auto row_size = columns.columns();
+      parallelFor(columns.rows(), thread_count, [&](const std::size_t, const std::size_t begin, const std::size_t end)
       {
-         for ( col = 0; col < col_size; ++col )
+         for ( auto col = begin; col < end; ++col )
          {
-            if ( matrix[row][col] != 0 && !std::binary_search(used_columns.cbegin(), used_columns.cend(), col) )
+            const auto entries = columns[col];
+            Integer gcd_val(0);
+            for ( RowIndex j = 0; j < row_size; ++j )
             {
-               break;
+               gcd_val = algorithm::gcd(gcd_val, entries[j]);
+            }
+            if ( gcd_val == 0 )
+            {
+               continue;
+            }
+            const auto pivot_entry = std::find_if(entries, entries + row_size, [](const Integer& a) { return a != 0; });
+            if ( *pivot_entry < 0 )
+            {
+               gcd_val = Integer(-gcd_val);
+            }
+            if ( gcd_val != 1 )
+            {
+               for ( RowIndex j = 0; j < row_size; ++j )
+               {
+                  entries[j] /= gcd_val;
+               }
             }
          }
-         if ( col < col_size )
-         {
-            break;
-         }
-      }
-      used_columns.push_back(col);
-      std::sort(used_columns.begin(), used_columns.end());
-      return std::make_pair(row, col);
+      });
    }
 }
-
@@ -10,6 +10,7 @@
 #include <iosfwd>
 #include <vector>
 
+#include "dense_matrix.h"
 #include "matrix.h"
 #include "names.h"
 #include "row.h"
@@ -42,15 +43,29 @@ namespace panda
       /// (relevant for Fourier-Motzkin elimination).
       template <typename Integer>
       std::pair<Indices, Indices> gaussianElimination(Matrix<Integer>&);
+      /// Gaussian elimination as above on a dense matrix.
+      template <typename Integer>
+      std::pair<Indices, Indices> gaussianElimination(DenseMatrix<Integer>&);
+      /// Gaussian elimination as above, the columns of each step are updated by the given number of threads.
+      /// The elimination is fraction-free (Bareiss), each column is divided by the gcd of its entries only at the end.
+      /// Built-in integer types divide each updated column by its gcd in every step instead, as they overflow silently.
+      template <typename Integer>
+      std::pair<Indices, Indices> gaussianElimination(DenseMatrix<Integer>&, const std::size_t);
       /// Used for gaussian elimination: First step of FME is to calculate an inverse.
       template <typename Integer>
       void appendNegativeIdentityMatrix(Matrix<Integer>&);
+      /// Appends the negative identity matrix to a dense matrix.
+      template <typename Integer>
+      void appendNegativeIdentityMatrix(DenseMatrix<Integer>&);
       /// Extracts the equations from a set of vertices.
       template <typename Integer>
       Equations<Integer> extractEquations(Matrix<Integer>);
       /// Extracts equations marked by indices in a matrix.
       template <typename Integer>
       Equations<Integer> extractEquations(Matrix<Integer>&, const Indices&);
+      /// Extracts equations marked by indices in a dense matrix.
+      template <typename Integer>
+      Equations<Integer> extractEquations(DenseMatrix<Integer>&, const Indices&);
    }
 }
 
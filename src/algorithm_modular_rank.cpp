@@ -0,0 +1,439 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_ALGORITHM_MODULAR_RANK
+#include "algorithm_modular_rank.h"
+#undef COMPILE_TEMPLATE_ALGORITHM_MODULAR_RANK
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include "algorithm_integer_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   using Residue = std::uint64_t;
+   /// Primes are taken downwards from 2^62, so sums of two residues do not overflow.
+   const Residue prime_limit = Residue(1) << 62;
+   /// Number of primes tried even if the Hadamard bound asks for fewer.
+   const std::size_t minimum_primes = 3;
+   /// Reduced row echelon form of a matrix modulo a prime.
+   struct Echelon
+   {
+      Residue prime;
+      /// Columns of the leading ones, ascending.
+      std::vector<std::size_t> pivot_columns;
+      /// The non-zero rows, row-major with the number of columns of the matrix as stride.
+      std::vector<Residue> rows;
+   };
+   /// Product of two residues modulo a prime.
+   Residue multiply(const Residue, const Residue, const Residue) noexcept;
+   /// Inverse of a non-zero residue modulo a prime.
+   Residue inverse(const Residue, const Residue) noexcept;
+   /// Power of a residue modulo a prime.
+   Residue power(Residue, Residue, const Residue) noexcept;
+   /// Largest prime below the given number, by a Miller-Rabin test with bases deterministic below 2^64.
+   Residue previousPrime(Residue) noexcept;
+   /// Upper bound of log2 of the absolute values of all minors (Hadamard bound).
+   template <typename Integer>
+   double hadamardBits(const Matrix<Integer>&);
+   /// Residue of an integer modulo a prime.
+   template <typename Integer>
+   Residue residue(Integer, const Residue);
+   /// Residue of a BigInteger, whose division of large negative numbers does not truncate like the built-in types.
+   Residue residue(const BigInteger&, const Residue);
+   /// Exact value of an integer of any of the supported types.
+   template <typename Integer>
+   BigInteger toBigInteger(Integer);
+   /// Identity on BigInteger.
+   BigInteger toBigInteger(const BigInteger&);
+   /// Computes the reduced row echelon form modulo a prime.
+   template <typename Integer>
+   Echelon echelon(const Matrix<Integer>&, const Residue);
+   /// Lifts a residue modulo the given modulus to a fraction with numerator and denominator at most the bound in absolute value.
+   /// Returns false if there is no such fraction.
+   bool reconstruct(const BigInteger&, const BigInteger&, const BigInteger&, BigInteger&, BigInteger&);
+   /// Lifts the kernel of the echelon forms, which agree in their pivot columns, and checks that the exact matrix maps it to zero.
+   bool kernelVanishes(const Matrix<BigInteger>&, const std::vector<Echelon>&);
+}
+
+template <typename Integer>
+std::pair<std::size_t, bool> panda::algorithm::modularRank(const Matrix<Integer>& matrix)
+{
+   assert( !matrix.empty() && !matrix.front().empty() );
+   const auto bound = std::min(matrix.size(), matrix.front().size());
+   // the entries of the reduced echelon form are quotients of minors, a fraction with numerator and denominator
+   // below 2^(31k - 1) is recovered from k primes.
+   const auto required_primes = std::max(minimum_primes, static_cast<std::size_t>(hadamardBits(matrix) / 31.0) + 2);
+   // echelon forms of the highest rank so far, which all have the same pivot columns.
+   std::vector<Echelon> lifted;
+   Matrix<BigInteger> exact;
+   auto prime = prime_limit;
+   for ( std::size_t k = 0; k < required_primes; ++k )
+   {
+      prime = previousPrime(prime);
+      auto form = echelon(matrix, prime);
+      const auto rank = form.pivot_columns.size();
+      if ( rank == bound )
+      {
+         return std::make_pair(rank, true);
+      }
+      if ( lifted.empty() || rank > lifted.front().pivot_columns.size() )
+      {
+         lifted.clear();
+      }
+      else if ( form.pivot_columns != lifted.front().pivot_columns )
+      {
+         continue;
+      }
+      lifted.push_back(std::move(form));
+      if ( exact.empty() )
+      {
+         for ( const auto& row : matrix )
+         {
+            exact.emplace_back();
+            for ( const auto& entry : row )
+            {
+               exact.back().push_back(toBigInteger(entry));
+            }
+         }
+      }
+      if ( kernelVanishes(exact, lifted) )
+      {
+         return std::make_pair(rank, true);
+      }
+   }
+   return std::make_pair(lifted.front().pivot_columns.size(), false);
+}
+
+namespace
+{
+   #ifdef __SIZEOF_INT128__
+   __extension__ typedef unsigned __int128 WideResidue;
+
+   Residue multiply(const Residue a, const Residue b, const Residue prime) noexcept
+   {
+      return static_cast<Residue>((static_cast<WideResidue>(a) * b) % prime);
+   }
+   #else
+   Residue multiply(const Residue a, const Residue b, const Residue prime) noexcept
+   {
+      // double and add, all intermediate values stay below 2^63.
+      Residue result = 0;
+      for ( auto bit = 62; bit >= 0; --bit )
+      {
+         result = (2 * result) % prime;
+         if ( (b >> bit) & 1 )
+         {
+            result = (result + a) % prime;
+         }
+      }
+      return result;
+   }
+   #endif
+
+   Residue power(Residue base, Residue exponent, const Residue prime) noexcept
+   {
+      Residue result = 1;
+      for ( ; exponent > 0; exponent >>= 1 )
+      {
+         if ( exponent & 1 )
+         {
+            result = multiply(result, base, prime);
+         }
+         base = multiply(base, base, prime);
+      }
+      return result;
+   }
+
+   Residue inverse(const Residue a, const Residue prime) noexcept
+   {
+      assert( a != 0 );
+      // Fermat: a^(p - 2) is the inverse of a.
+      return power(a, prime - 2, prime);
+   }
+
+   Residue previousPrime(Residue n) noexcept
+   {
+      assert( n > 3 && n <= prime_limit );
+      const Residue bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+      for ( n -= (n % 2 == 0) ? 1 : 2; ; n -= 2 )
+      {
+         auto odd = n - 1;
+         unsigned twos = 0;
+         for ( ; odd % 2 == 0; odd /= 2 )
+         {
+            ++twos;
+         }
+         const auto witness = std::any_of(std::begin(bases), std::end(bases), [&](const Residue base)
+         {
+            auto x = power(base % n, odd, n);
+            if ( x == 1 || x == n - 1 )
+            {
+               return false;
+            }
+            for ( unsigned i = 1; i < twos; ++i )
+            {
+               x = multiply(x, x, n);
+               if ( x == n - 1 )
+               {
+                  return false;
+               }
+            }
+            return true;
+         });
+         if ( !witness )
+         {
+            return n;
+         }
+      }
+   }
+
+   template <typename Integer>
+   double hadamardBits(const Matrix<Integer>& matrix)
+   {
+      // log2 of the euclidean norm of each row, the product of the largest norms bounds every minor.
+      std::vector<double> norms;
+      for ( const auto& row : matrix )
+      {
+         double largest = 0.0;
+         for ( const auto& entry : row )
+         {
+            // log2 of an entry is bounded by its number of base 2^14 digits and its leading digit.
+            const Integer base(static_cast<int16_t>(1 << 14));
+            std::size_t digits = 0;
+            int leading = 0;
+            for ( auto value = entry; value != 0; value = Integer(value / base) )
+            {
+               leading = static_cast<int>(value % base);
+               ++digits;
+            }
+            if ( digits > 0 )
+            {
+               largest = std::max(largest, 14.0 * static_cast<double>(digits - 1) + std::log2(std::abs(leading) + 1.0));
+            }
+         }
+         norms.push_back(largest + 0.5 * std::log2(static_cast<double>(row.size())));
+      }
+      std::sort(norms.rbegin(), norms.rend());
+      const auto count = std::min(norms.size(), matrix.front().size());
+      return std::accumulate(norms.cbegin(), norms.cbegin() + static_cast<std::vector<double>::difference_type>(count), 0.0);
+   }
+
+   template <typename Integer>
+   Residue residue(Integer value, const Residue prime)
+   {
+      // digits of base 2^14 are representable in every supported type, they are combined from the most significant one.
+      const Integer base(static_cast<int16_t>(1 << 14));
+      std::vector<int> digits;
+      while ( value != 0 )
+      {
+         digits.push_back(static_cast<int>(value % base));
+         value = Integer(value / base);
+      }
+      Residue result = 0;
+      for ( auto it = digits.crbegin(); it != digits.crend(); ++it )
+      {
+         result = multiply(result, Residue(1) << 14, prime);
+         const auto digit = static_cast<Residue>(*it < 0 ? -*it : *it);
+         result = (*it < 0) ? (result + prime - digit) % prime : (result + digit) % prime;
+      }
+      return result;
+   }
+
+   Residue residue(const BigInteger& value, const Residue prime)
+   {
+      if ( value < 0 )
+      {
+         return (prime - residue<BigInteger>(-value, prime)) % prime;
+      }
+      return residue<BigInteger>(value, prime);
+   }
+
+   template <typename Integer>
+   BigInteger toBigInteger(Integer value)
+   {
+      const Integer base(static_cast<int16_t>(1 << 14));
+      std::vector<int> digits;
+      while ( value != 0 )
+      {
+         digits.push_back(static_cast<int>(value % base));
+         value = Integer(value / base);
+      }
+      BigInteger result(0);
+      for ( auto it = digits.crbegin(); it != digits.crend(); ++it )
+      {
+         result *= BigInteger(static_cast<int32_t>(1 << 14));
+         result += BigInteger(static_cast<int32_t>(*it));
+      }
+      return result;
+   }
+
+   BigInteger toBigInteger(const BigInteger& value)
+   {
+      return value;
+   }
+
+   template <typename Integer>
+   Echelon echelon(const Matrix<Integer>& matrix, const Residue prime)
+   {
+      const auto row_count = matrix.size();
+      const auto columns = matrix.front().size();
+      std::vector<Residue> entries(row_count * columns);
+      for ( std::size_t i = 0; i < row_count; ++i )
+      {
+         for ( std::size_t j = 0; j < columns; ++j )
+         {
+            entries[i * columns + j] = residue(matrix[i][j], prime);
+         }
+      }
+      const auto row = [&](const std::size_t i)
+      {
+         return entries.begin() + static_cast<std::vector<Residue>::difference_type>(i * columns);
+      };
+      Echelon form{prime, {}, {}};
+      std::size_t rank = 0;
+      for ( std::size_t col = 0; col < columns && rank < row_count; ++col )
+      {
+         std::size_t i = rank;
+         while ( i < row_count && entries[i * columns + col] == 0 )
+         {
+            ++i;
+         }
+         if ( i == row_count )
+         {
+            continue;
+         }
+         std::swap_ranges(row(i), row(i) + static_cast<std::vector<Residue>::difference_type>(columns), row(rank));
+         // entries left of col are zero in the pivot row.
+         const auto scale = inverse(entries[rank * columns + col], prime);
+         for ( auto j = col; j < columns; ++j )
+         {
+            entries[rank * columns + j] = multiply(entries[rank * columns + j], scale, prime);
+         }
+         for ( i = 0; i < row_count; ++i )
+         {
+            const auto factor = entries[i * columns + col];
+            if ( i == rank || factor == 0 )
+            {
+               continue;
+            }
+            for ( auto j = col; j < columns; ++j )
+            {
+               const auto product = multiply(factor, entries[rank * columns + j], prime);
+               auto& entry = entries[i * columns + j];
+               entry = (entry >= product) ? entry - product : entry + prime - product;
+            }
+         }
+         form.pivot_columns.push_back(col);
+         ++rank;
+      }
+      entries.resize(rank * columns);
+      form.rows = std::move(entries);
+      return form;
+   }
+
+   bool reconstruct(const BigInteger& value, const BigInteger& modulus, const BigInteger& bound, BigInteger& numerator, BigInteger& denominator)
+   {
+      // extended Euclidean algorithm on (modulus, value), stopped at the first remainder within the bound.
+      BigInteger r0 = modulus;
+      BigInteger r1 = value;
+      BigInteger t0(0);
+      BigInteger t1(1);
+      while ( r1 > bound )
+      {
+         const auto quotient = r0 / r1;
+         auto r2 = r0 - quotient * r1;
+         auto t2 = t0 - quotient * t1;
+         r0 = std::move(r1);
+         r1 = std::move(r2);
+         t0 = std::move(t1);
+         t1 = std::move(t2);
+      }
+      if ( t1 == 0 || abs(t1) > bound )
+      {
+         return false;
+      }
+      numerator = (t1 < 0) ? -r1 : r1;
+      denominator = abs(t1);
+      return true;
+   }
+
+   bool kernelVanishes(const Matrix<BigInteger>& exact, const std::vector<Echelon>& forms)
+   {
+      assert( !forms.empty() );
+      const auto columns = exact.front().size();
+      const auto& pivot_columns = forms.front().pivot_columns;
+      const auto rank = pivot_columns.size();
+      // the product of k primes exceeds 2^(62k - 1), so fractions with numerator and denominator below 2^(31k - 1) are unique.
+      BigInteger modulus(1);
+      BigInteger bound(1);
+      for ( const auto& form : forms )
+      {
+         modulus *= BigInteger(form.prime);
+         bound *= BigInteger(static_cast<int64_t>(1) << 31);
+      }
+      bound = bound / BigInteger(static_cast<int32_t>(2));
+      std::vector<bool> is_pivot(columns, false);
+      for ( const auto col : pivot_columns )
+      {
+         is_pivot[col] = true;
+      }
+      for ( std::size_t free = 0; free < columns; ++free )
+      {
+         if ( is_pivot[free] )
+         {
+            continue;
+         }
+         // the kernel vector is one in the free column and -rows[k][free] in pivot column k.
+         std::vector<BigInteger> numerators(rank);
+         std::vector<BigInteger> denominators(rank);
+         BigInteger common(1);
+         for ( std::size_t k = 0; k < rank; ++k )
+         {
+            // Chinese remaindering of the entries of all forms.
+            BigInteger value(0);
+            BigInteger partial_modulus(1);
+            for ( const auto& form : forms )
+            {
+               const auto prime = form.prime;
+               const auto target = (prime - form.rows[k * columns + free]) % prime;
+               const auto current = residue(value, prime);
+               const auto difference = (target + prime - current) % prime;
+               const auto factor = multiply(difference, inverse(residue(partial_modulus, prime), prime), prime);
+               value += partial_modulus * BigInteger(factor);
+               partial_modulus *= BigInteger(prime);
+            }
+            if ( !reconstruct(value, modulus, bound, numerators[k], denominators[k]) )
+            {
+               return false;
+            }
+            common = common / algorithm::gcd(common, denominators[k]) * denominators[k];
+         }
+         for ( const auto& row : exact )
+         {
+            BigInteger sum = row[free] * common;
+            for ( std::size_t k = 0; k < rank; ++k )
+            {
+               sum += row[pivot_columns[k]] * numerators[k] * (common / denominators[k]);
+            }
+            if ( sum != 0 )
+            {
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+}
@@ -0,0 +1,28 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "matrix.h"
+
+namespace panda
+{
+   namespace algorithm
+   {
+      /// Rank of a matrix by elimination modulo primes below 2^62, free of coefficient growth and overflows.
+      /// The rank modulo a prime never exceeds the rank. It is confirmed if it equals the number of rows or columns,
+      /// or if the kernel modulo the primes lifts (Chinese remaindering and rational reconstruction) to integer vectors
+      /// the matrix maps to zero. Further primes are only used while the lift fails.
+      /// Returns the rank and whether it is confirmed. An unconfirmed rank is a lower bound.
+      template <typename Integer>
+      std::pair<std::size_t, bool> modularRank(const Matrix<Integer>&);
+   }
+}
+
+#include "algorithm_modular_rank.eti"
@@ -10,26 +10,49 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <set>
+#include <utility>
 
 #include "algorithm_classes.h"
 #include "algorithm_fourier_motzkin_elimination.h"
 #include "algorithm_inequality_operations.h"
 #include "algorithm_integer_operations.h"
+#include "algorithm_map_operations.h"
+#include "algorithm_matrix_operations.h"
 #include "algorithm_row_operations.h"
+#include "distance_engine.h"
 
 using namespace panda;
 
 namespace
 {
-   /// Rotates a facet around a ridge. It's the exact same algorithm as for vertices.
+   /// Rotates a facet around a ridge, starting at the vertex with the given index. It's the exact same algorithm as for vertices.
    template <typename Integer>
-   Facet<Integer> rotate(const Vertices<Integer>&, Vertex<Integer>, const Facet<Integer>&, Facet<Integer>);
-   /// Returns all ridges on a facet (equivalent to all facets of the facet).
+   Facet<Integer> rotate(const Vertices<Integer>&, const DistanceEngine<Integer>&, std::size_t, const Facet<Integer>&, Facet<Integer>);
+   /// Rotates a facet around its ridges, with recursive adjacency decomposition only around their class representatives
+   /// under the maps leaving the facet unchanged. The rotated facets are neither normalized nor reduced to classes.
+   template <typename Integer, typename TagType>
+   Inequalities<Integer> rotateAroundRidges(const Vertices<Integer>&, const Facet<Integer>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<Integer>*);
+   /// Returns all ridges on a facet (equivalent to all facets of the facet), with recursive adjacency decomposition
+   /// only their class representatives under the maps leaving the facet unchanged.
+   template <typename Integer, typename TagType>
+   Inequalities<Integer> getRidges(const Vertices<Integer>&, const DistanceEngine<Integer>&, const Facet<Integer>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<Integer>*);
+   /// Computes the class representatives of all facets of the polytope spanned by the vertices by adjacency decomposition.
+   template <typename Integer, typename TagType>
+   Inequalities<Integer> adjacencyDecomposition(const Vertices<Integer>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<Integer>*);
+   /// Returns the maps that leave the row unchanged. They generate a subgroup of its stabilizer.
+   template <typename Integer, typename TagType>
+   Maps stabilizingMaps(const Row<Integer>&, const Maps&, TagType);
+   /// Equations of the polytope spanned by the vertices, by which its facets are normalized.
    template <typename Integer>
-   Inequalities<Integer> getRidges(const Vertices<Integer>&, const Facet<Integer>&);
+   Equations<Integer> subproblemEquations(const Vertices<Integer>&, tag::facet);
+   /// Rows in vertex enumeration are not normalized.
+   template <typename Integer>
+   Equations<Integer> subproblemEquations(const Vertices<Integer>&, tag::vertex);
    /// Returns all vertices that lie on the facet (satisfy the inequality with equality).
    template <typename Integer>
-   Vertices<Integer> verticesWithZeroDistance(const Vertices<Integer>&, const Facet<Integer>&);
+   Vertices<Integer> verticesWithZeroDistance(const Vertices<Integer>&, const DistanceEngine<Integer>&, const Facet<Integer>&);
 }
 
 template <typename Integer, typename TagType>
@@ -38,27 +61,55 @@ Matrix<Integer> panda::algorithm::rotation(const Matrix<Integer>& matrix,
                                     const Maps& maps,
                                     TagType tag)
 {
-   // as the first step of the rotation, the furthest Vertex w.r.t. the input facet is calculated.
-   // this will be the same vertex for all neighbouring ridges, hence, only needs to be computed once.
-   const auto furthest_vertex = furthestVertex(matrix, input);
-   const auto ridges = getRidges(matrix, input);
-   std::set<Row<Integer>> output;
-   for ( const auto& ridge : ridges )
+   return rotation<Integer>(matrix, input, maps, tag, AdjacencyDecompositionSettings(), [](const std::size_t size, const std::function<void(std::size_t)>& function)
    {
-      const auto new_row = rotate(matrix, furthest_vertex, input, ridge);
-      output.insert(new_row);
-   }
-   return classes(output, maps, tag);
+      for ( std::size_t k = 0; k < size; ++k )
+      {
+         function(k);
+      }
+   }, nullptr);
+}
+
+template <typename Integer, typename TagType>
+Matrix<Integer> panda::algorithm::rotation(const Matrix<Integer>& matrix,
+                                    const Row<Integer>& input,
+                                    const Maps& maps,
+                                    TagType tag,
+                                    const AdjacencyDecompositionSettings& settings,
+                                    const ForEach& for_each,
+                                    RidgeCache<Integer>* const cache)
+{
+   const auto rotated = rotateAroundRidges(matrix, input, maps, tag, settings, for_each, cache);
+   std::set<Row<Integer>> output(rotated.cbegin(), rotated.cend());
+   return classes(std::move(output), maps, tag);
 }
 
 namespace
 {
+   template <typename Integer, typename TagType>
+   Inequalities<Integer> rotateAroundRidges(const Vertices<Integer>& vertices, const Facet<Integer>& facet, const Maps& maps, TagType tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<Integer>* const cache)
+   {
+      // all distances of the rotation are evaluated against the same vertices, which are therefore laid out once.
+      const DistanceEngine<Integer> engine(vertices);
+      // as the first step of the rotation, the furthest Vertex w.r.t. the input facet is calculated.
+      // this will be the same vertex for all neighbouring ridges, hence, only needs to be computed once.
+      const auto furthest_vertex = engine.furthest(facet);
+      const auto ridges = getRidges(vertices, engine, facet, maps, tag, settings, for_each, cache);
+      // each rotation writes to its own row, so the result does not depend on the order of the tasks.
+      Inequalities<Integer> rotated(ridges.size());
+      for_each(ridges.size(), [&](const std::size_t k)
+      {
+         rotated[k] = rotate(vertices, engine, furthest_vertex, facet, ridges[k]);
+      });
+      return rotated;
+   }
+
    template <typename Integer>
-   Facet<Integer> rotate(const Vertices<Integer>& vertices, Vertex<Integer> vertex, const Facet<Integer>& facet, Facet<Integer> ridge)
+   Facet<Integer> rotate(const Vertices<Integer>& vertices, const DistanceEngine<Integer>& engine, std::size_t vertex, const Facet<Integer>& facet, Facet<Integer> ridge)
    {
       // the calculation of the initial vertex, which has to be the furthest vertex w.r.t. "facet", is calculated outside of this function as it is the same for all rotations.
-      auto d_f = algorithm::distance(facet, vertex);
-      auto d_r = algorithm::distance(ridge, vertex);
+      auto d_f = algorithm::distance(facet, vertices[vertex]);
+      auto d_r = algorithm::distance(ridge, vertices[vertex]);
       do
       {
          const auto gcd_ds = algorithm::gcd(d_f, d_r);
@@ -74,30 +125,101 @@ namespace
          {
             ridge /= gcd_value;
          }
-         vertex = algorithm::nearestVertex(vertices, ridge);
-         d_f = algorithm::distance(facet, vertex);
-         d_r = algorithm::distance(ridge, vertex);
+         vertex = engine.nearest(ridge);
+         d_f = algorithm::distance(facet, vertices[vertex]);
+         d_r = algorithm::distance(ridge, vertices[vertex]);
       }
       while ( d_r != 0 );
       return ridge;
    }
 
-   template <typename Integer>
-   Inequalities<Integer> getRidges(const Vertices<Integer>& vertices, const Facet<Integer>& facet)
+   template <typename Integer, typename TagType>
+   Inequalities<Integer> getRidges(const Vertices<Integer>& vertices, const DistanceEngine<Integer>& engine, const Facet<Integer>& facet, const Maps& maps, TagType tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<Integer>* const cache)
    {
-      const auto vertices_on_facet = verticesWithZeroDistance(vertices, facet);
+      const auto vertices_on_facet = verticesWithZeroDistance(vertices, engine, facet);
       assert( !vertices_on_facet.empty() );
-      return algorithm::fourierMotzkinElimination(vertices_on_facet);
+      if ( settings.recursion_threshold > 0 && vertices_on_facet.size() > settings.recursion_threshold )
+      {
+         // rotating around ridges in the same class of the stabilizer yields facets in the same class.
+         return adjacencyDecomposition(vertices_on_facet, stabilizingMaps(facet, maps, tag), tag, settings, for_each, cache);
+      }
+      // the steps of the elimination are split for all threads, idle workers steal their chunks.
+      FourierMotzkinSettings elimination_settings;
+      elimination_settings.thread_count = settings.thread_count;
+      elimination_settings.for_each = for_each;
+      if ( cache != nullptr )
+      {
+         return cache->ridges(vertices_on_facet, [&elimination_settings](const Vertices<Integer>& rows)
+         {
+            return algorithm::fourierMotzkinElimination(rows, elimination_settings);
+         });
+      }
+      return algorithm::fourierMotzkinElimination(vertices_on_facet, elimination_settings);
+   }
+
+   template <typename Integer, typename TagType>
+   Inequalities<Integer> adjacencyDecomposition(const Vertices<Integer>& vertices, const Maps& original_maps, TagType tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<Integer>* const cache)
+   {
+      const auto equations = subproblemEquations(vertices, tag);
+      const auto maps = algorithm::normalize(original_maps, equations);
+      std::set<Row<Integer>> known;
+      Inequalities<Integer> jobs;
+      const auto add = [&](const Row<Integer>& row)
+      {
+         auto representative = algorithm::classRepresentative(algorithm::normalize(row, equations), maps, tag);
+         if ( known.insert(representative).second )
+         {
+            jobs.push_back(std::move(representative));
+         }
+      };
+      for ( const auto& row : algorithm::fourierMotzkinEliminationHeuristic(vertices) )
+      {
+         add(row);
+      }
+      for ( std::size_t k = 0; k < jobs.size(); ++k )
+      {
+         const auto job = jobs[k];
+         // the stabilizer of the job within the maps carries on to deeper levels of the recursion.
+         // the neighbours are normalized before their class representatives are taken.
+         for ( const auto& row : rotateAroundRidges(vertices, job, maps, tag, settings, for_each, cache) )
+         {
+            add(row);
+         }
+      }
+      return jobs;
+   }
+
+   template <typename Integer, typename TagType>
+   Maps stabilizingMaps(const Row<Integer>& row, const Maps& maps, TagType tag)
+   {
+      Maps stabilizing;
+      std::copy_if(maps.cbegin(), maps.cend(), std::back_inserter(stabilizing), [&](const Map& map)
+      {
+         return algorithm::apply(map, row, tag) == row;
+      });
+      return stabilizing;
+   }
+
+   template <typename Integer>
+   Equations<Integer> subproblemEquations(const Vertices<Integer>& vertices, tag::facet)
+   {
+      return algorithm::extractEquations(vertices);
    }
 
    template <typename Integer>
-   Vertices<Integer> verticesWithZeroDistance(const Vertices<Integer>& vertices, const Facet<Integer>& facet)
+   Equations<Integer> subproblemEquations(const Vertices<Integer>&, tag::vertex)
+   {
+      return Equations<Integer>();
+   }
+
+   template <typename Integer>
+   Vertices<Integer> verticesWithZeroDistance(const Vertices<Integer>& vertices, const DistanceEngine<Integer>& engine, const Facet<Integer>& facet)
    {
       Vertices<Integer> selection;
-      std::copy_if(vertices.cbegin(), vertices.cend(), std::back_inserter(selection), [&facet](const Vertex<Integer>& vertex)
+      for ( const auto index : engine.zeroDistance(facet) )
       {
-         return (algorithm::distance(facet, vertex) == 0);
-      });
+         selection.push_back(vertices[index]);
+      }
       return selection;
    }
 }
@@ -6,8 +6,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
+
+#include "adjacency_decomposition_settings.h"
+#include "for_each.h"
 #include "maps.h"
 #include "matrix.h"
+#include "ridge_cache.h"
 #include "row.h"
 #include "tags.h"
 
@@ -18,6 +24,13 @@ namespace panda
       /// Returns all adjacent rows (or class representatives) of a row by using the rotation algorithm.
       template <typename Integer, typename TagType>
       Facets<Integer> rotation(const Vertices<Integer>&, const Facet<Integer>&, const Maps&, TagType);
+      using panda::ForEach;
+      /// As above, the rotations around the ridges are independent tasks handed to the given ForEach.
+      /// So are the chunks of the parallel loops of the Fourier-Motzkin elimination computing the ridges.
+      /// If the row has more incident rows than the recursion threshold of the settings, its ridges are computed by adjacency decomposition.
+      /// Ridges computed by Fourier-Motzkin elimination are looked up in the cache, unless it is null.
+      template <typename Integer, typename TagType>
+      Facets<Integer> rotation(const Vertices<Integer>&, const Facet<Integer>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const ForEach&, RidgeCache<Integer>*);
    }
 }
 
@@ -0,0 +1,152 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Microbenchmark of the pair loop of the Fourier-Motzkin elimination: for all pairs of negative and positive rows,
+/// the count check and, for pairs passing it, the containment check against all rows on the hyperplane.
+/// The bitsets with 64-bit words and vector kernels are compared to the former implementation with 32-bit words and scalar loops.
+/// Build with "make benchmarks" and run ./benchmark_bitset_kernels.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bitset_fixed_size.h"
+#include "bitset_variable_size.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Former fixed size bitset: 32-bit words, three popcounts per word for the union count and an early exit per word.
+   template <std::size_t Size>
+   class ScalarBitset
+   {
+      public:
+         using DataType = uint32_t;
+         explicit ScalarBitset(const std::size_t)
+         :
+            data()
+         {
+         }
+         void set(const std::size_t index) noexcept
+         {
+            data[index / 32] |= DataType(1) << (index % 32);
+         }
+         static std::size_t unionCount(const ScalarBitset& a, const ScalarBitset& b, const std::size_t max) noexcept
+         {
+            std::size_t total = 0;
+            for ( std::size_t i = 0; i < 1 + (max - 1) / 32; ++i )
+            {
+               total += static_cast<std::size_t>(__builtin_popcount(a.data[i]));
+               total += static_cast<std::size_t>(__builtin_popcount(b.data[i]));
+               total -= static_cast<std::size_t>(__builtin_popcount(a.data[i] & b.data[i]));
+            }
+            return total;
+         }
+         static bool unionContains(const ScalarBitset& a, const ScalarBitset& b, const ScalarBitset& inner, const std::size_t max) noexcept
+         {
+            for ( std::size_t i = 0; i < 1 + (max - 1) / 32; ++i )
+            {
+               if ( ((a.data[i] | b.data[i]) & inner.data[i]) != inner.data[i] )
+               {
+                  return false;
+               }
+            }
+            return true;
+         }
+      private:
+         std::array<DataType, Size> data;
+   };
+
+   /// Random bitsets of the given number of bits. Rows on the hyperplane have fewer bits, so that some pairs are rejected late.
+   template <typename Bitset>
+   std::vector<Bitset> randomBitsets(std::mt19937& generator, const std::size_t count, const std::size_t bits, const double density)
+   {
+      std::bernoulli_distribution coin(density);
+      std::vector<Bitset> bitsets(count, Bitset(bits));
+      for ( auto& bitset : bitsets )
+      {
+         for ( std::size_t i = 0; i < bits; ++i )
+         {
+            if ( coin(generator) )
+            {
+               bitset.set(i);
+            }
+         }
+      }
+      return bitsets;
+   }
+
+   /// Nanoseconds per pair of the pair loop and the number of adjacent pairs.
+   template <typename Bitset>
+   std::pair<double, std::size_t> pairLoop(const std::size_t bits)
+   {
+      std::mt19937 generator(11);
+      const auto negative = randomBitsets<Bitset>(generator, 300, bits, 0.25);
+      const auto positive = randomBitsets<Bitset>(generator, 300, bits, 0.25);
+      const auto zero = randomBitsets<Bitset>(generator, 200, bits, 0.08);
+      // about a tenth of the pairs pass the count check.
+      const auto mean = 0.4375 * static_cast<double>(bits);
+      const auto max_count = static_cast<std::size_t>(mean - 1.28 * std::sqrt(mean * 0.5625));
+      std::size_t adjacent = 0;
+      std::size_t repetitions = 0;
+      const auto start = std::chrono::steady_clock::now();
+      auto elapsed = std::chrono::steady_clock::duration::zero();
+      while ( elapsed < std::chrono::milliseconds(300) )
+      {
+         for ( const auto& n : negative )
+         {
+            for ( const auto& p : positive )
+            {
+               if ( Bitset::unionCount(n, p, bits) <= max_count && std::none_of(zero.cbegin(), zero.cend(), [&](const Bitset& z) { return Bitset::unionContains(n, p, z, bits); }) )
+               {
+                  ++adjacent;
+               }
+            }
+         }
+         ++repetitions;
+         elapsed = std::chrono::steady_clock::now() - start;
+      }
+      const auto pairs = static_cast<double>(repetitions * negative.size() * positive.size());
+      return std::make_pair(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / pairs, adjacent / repetitions);
+   }
+
+   template <std::size_t Bits>
+   void compare()
+   {
+      const auto before = pairLoop<ScalarBitset<(Bits + 31) / 32>>(Bits);
+      const auto fixed = pairLoop<BitsetFixedSize<(Bits + 63) / 64>>(Bits);
+      const auto variable = pairLoop<BitsetVariableSize>(Bits);
+      if ( before.second != fixed.second || before.second != variable.second )
+      {
+         std::cerr << "Results differ for " << Bits << " bits.\n";
+      }
+      std::cout << std::setw(6) << Bits
+                << std::setw(12) << std::fixed << std::setprecision(1) << before.first
+                << std::setw(12) << fixed.first
+                << std::setw(12) << variable.first
+                << std::setw(10) << std::setprecision(2) << before.first / fixed.first << "x"
+                << std::setw(10) << before.second << '\n';
+   }
+}
+
+int main()
+{
+   std::cout << std::setw(6) << "bits" << std::setw(12) << "32-bit ns" << std::setw(12) << "fixed ns" << std::setw(12) << "variable ns" << std::setw(11) << "speedup" << std::setw(10) << "adjacent" << '\n';
+   compare<60>();
+   compare<200>();
+   compare<500>();
+   compare<1000>();
+   compare<3000>();
+   compare<6000>();
+}
+
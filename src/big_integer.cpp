@@ -9,7 +9,9 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <stdexcept>
 
 using namespace panda;
@@ -86,6 +88,39 @@ BigInteger panda::abs(BigInteger input) noexcept
    return input;
 }
 
+void panda::writeBinary(std::ostream& stream, const BigInteger& n)
+{
+   const char negative = (n.sign == BigInteger::Sign::Negative) ? 1 : 0;
+   const auto size = static_cast<uint64_t>(n.data.size());
+   stream.write(&negative, 1);
+   stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+   for ( const auto block : n.data )
+   {
+      const auto value = static_cast<uint64_t>(block);
+      stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+   }
+}
+
+void panda::readBinary(std::istream& stream, BigInteger& n)
+{
+   char negative = 0;
+   uint64_t size = 0;
+   stream.read(&negative, 1);
+   stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+   if ( !stream )
+   {
+      return;
+   }
+   n.sign = (negative != 0) ? BigInteger::Sign::Negative : BigInteger::Sign::Positive;
+   n.data.clear();
+   for ( uint64_t i = 0; i < size && stream; ++i )
+   {
+      uint64_t value = 0;
+      stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+      n.data.push_back(static_cast<BigInteger::DataType>(value));
+   }
+}
+
 BigInteger panda::BigInteger::divideMagnitudesWithRemainder(const BigInteger& second)
 {
    if ( isMagnitudeSmallerThan(second) )
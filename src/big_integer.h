@@ -17,6 +17,10 @@ namespace panda
 
    /// Absolute value.
    BigInteger abs(BigInteger) noexcept;
+   /// Writes the integer to a binary stream.
+   void writeBinary(std::ostream&, const BigInteger&);
+   /// Reads an integer written by writeBinary.
+   void readBinary(std::istream&, BigInteger&);
 
    class BigInteger
    {
@@ -97,6 +101,8 @@ namespace panda
          BigInteger operator-() const;
          /// Absolute value.
          friend BigInteger abs(BigInteger) noexcept;
+         friend void writeBinary(std::ostream&, const BigInteger&);
+         friend void readBinary(std::istream&, BigInteger&);
       private:
          /// Underlying data type.
          using DataType = uint_fast32_t;
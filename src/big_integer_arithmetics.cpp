@@ -89,9 +89,10 @@ BigInteger& panda::BigInteger::operator/=(const BigInteger& second)
    }
    catch ( ... ) // catch failed attempt of falling back to integer operation
    {
-      const auto original_sign = sign;
-      auto r = divideMagnitudesWithRemainder(second);
-      if ( second.sign != original_sign )
+      // the quotient of magnitudes may carry the sign of the dividend, it is set from both signs here.
+      const auto negative_quotient = (sign != second.sign);
+      divideMagnitudesWithRemainder(second);
+      if ( !isZero() && isNegative() != negative_quotient )
       {
          flipSign();
       }
@@ -10,6 +10,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "bitset_kernels.h"
+
 namespace panda
 {
    /// A class for fixed size bitsets with methods for equality, containment checks and merging.
@@ -21,7 +23,7 @@ namespace panda
          static std::size_t unionCount(const BitsetFixedSize<Size>&, const BitsetFixedSize<Size>&, const std::size_t) noexcept;
          static bool unionContains(const BitsetFixedSize<Size>&, const BitsetFixedSize<Size>&, const BitsetFixedSize<Size>&, const std::size_t) noexcept;
          /// Underlying data type.
-         using DataType = uint32_t;
+         using DataType = kernels::Word;
          /// Constructor: argument denotes number of bits.
          BitsetFixedSize(const std::size_t);
          /// Default copy constructor.
@@ -42,6 +44,11 @@ namespace panda
          std::size_t count(const std::size_t) const noexcept;
          /// Sets the i^th bit.
          void set(const std::size_t) noexcept;
+         /// Returns the i^th bit.
+         bool test(const std::size_t) const noexcept;
+      private:
+         /// Number of words to process for a hint of highest set bit.
+         static constexpr std::size_t words(const std::size_t) noexcept;
       private:
          std::array<DataType, Size> data;
    };
@@ -0,0 +1,35 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace panda
+{
+   /// Word-wise operations shared by the bitset classes.
+   /// Each function works on the given number of words of its arguments.
+   /// Depending on the instruction set the code is compiled for, AVX-512 or AVX2 instructions are used for long bitsets.
+   namespace kernels
+   {
+      /// Underlying data type of all bitsets.
+      using Word = uint64_t;
+      /// Returns the number of bits set in the union of two bitsets.
+      inline std::size_t unionCount(const Word*, const Word*, const std::size_t) noexcept;
+      /// Returns the number of bits set.
+      inline std::size_t count(const Word*, const std::size_t) noexcept;
+      /// Checks if the second bitset is contained in the first.
+      inline bool contains(const Word*, const Word*, const std::size_t) noexcept;
+      /// Checks if the third bitset is contained in the union of the first two.
+      inline bool unionContains(const Word*, const Word*, const Word*, const std::size_t) noexcept;
+      /// Adds the bits of the second bitset to the first.
+      inline void merge(Word*, const Word*, const std::size_t) noexcept;
+   }
+}
+
+#include "bitset_kernels.tpp"
+
@@ -0,0 +1,137 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// The vector paths are chosen at compile time by the flags of the target machine (-march=native in release builds).
+/// AVX-512 with VPOPCNTDQ counts eight words per instruction, AVX2 checks containment of four words per instruction.
+/// Short bitsets, which are the most common ones, are handled by the scalar loops, which compilers unroll and vectorize themselves.
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+   #include <immintrin.h>
+#endif
+
+#include "popcount.h"
+
+namespace panda
+{
+   namespace kernels
+   {
+      #if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+         /// Sum of the eight lanes of a vector.
+         inline std::size_t sum512(const __m512i sum) noexcept
+         {
+            Word lanes[8];
+            _mm512_storeu_si512(lanes, sum);
+            std::size_t total = 0;
+            for ( const auto lane : lanes )
+            {
+               total += static_cast<std::size_t>(lane);
+            }
+            return total;
+         }
+      #endif
+
+      std::size_t unionCount(const Word* a, const Word* b, const std::size_t words) noexcept
+      {
+         std::size_t i = 0;
+         std::size_t total = 0;
+         #if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+            const auto vector_words = words - words % 8;
+            if ( vector_words > 0 )
+            {
+               auto sum = _mm512_setzero_si512();
+               for ( ; i < vector_words; i += 8 )
+               {
+                  const auto x = _mm512_or_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+                  sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(x));
+               }
+               total = sum512(sum);
+            }
+         #endif
+         for ( ; i < words; ++i )
+         {
+            total += static_cast<std::size_t>(popcount(a[i] | b[i]));
+         }
+         return total;
+      }
+
+      std::size_t count(const Word* a, const std::size_t words) noexcept
+      {
+         std::size_t i = 0;
+         std::size_t total = 0;
+         #if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+            const auto vector_words = words - words % 8;
+            if ( vector_words > 0 )
+            {
+               auto sum = _mm512_setzero_si512();
+               for ( ; i < vector_words; i += 8 )
+               {
+                  sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_loadu_si512(a + i)));
+               }
+               total = sum512(sum);
+            }
+         #endif
+         for ( ; i < words; ++i )
+         {
+            total += static_cast<std::size_t>(popcount(a[i]));
+         }
+         return total;
+      }
+
+      bool contains(const Word* outer, const Word* inner, const std::size_t words) noexcept
+      {
+         std::size_t i = 0;
+         #if defined(__AVX2__)
+            for ( const auto vector_words = words - words % 4; i < vector_words; i += 4 )
+            {
+               const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(outer + i));
+               const auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inner + i));
+               // testc checks (~x & y) == 0.
+               if ( !_mm256_testc_si256(x, y) )
+               {
+                  return false;
+               }
+            }
+         #endif
+         Word missing = 0;
+         for ( ; i < words; ++i )
+         {
+            missing |= inner[i] & ~outer[i];
+         }
+         return missing == 0;
+      }
+
+      bool unionContains(const Word* a, const Word* b, const Word* inner, const std::size_t words) noexcept
+      {
+         std::size_t i = 0;
+         #if defined(__AVX2__)
+            for ( const auto vector_words = words - words % 4; i < vector_words; i += 4 )
+            {
+               const auto x = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+               const auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inner + i));
+               if ( !_mm256_testc_si256(x, y) )
+               {
+                  return false;
+               }
+            }
+         #endif
+         Word missing = 0;
+         for ( ; i < words; ++i )
+         {
+            missing |= inner[i] & ~(a[i] | b[i]);
+         }
+         return missing == 0;
+      }
+
+      void merge(Word* a, const Word* b, const std::size_t words) noexcept
+      {
+         for ( std::size_t i = 0; i < words; ++i )
+         {
+            a[i] |= b[i];
+         }
+      }
+   }
+}
+
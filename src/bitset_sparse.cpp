@@ -0,0 +1,377 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "bitset_sparse.h"
+#include "popcount.h"
+
+using namespace panda;
+
+namespace
+{
+   constexpr std::size_t digits = std::numeric_limits<BitsetSparse::DataType>::digits;
+
+   std::size_t wordCount(const std::size_t bits) noexcept
+   {
+      return (bits + digits - 1) / digits;
+   }
+
+   /// A list of positions takes 32 bits per position, a dense bitset one bit per position.
+   /// The thresholds for switching differ by a factor of two, so that a bitset does not switch back and forth.
+   bool preferDense(const std::size_t unset_count, const std::size_t frontier) noexcept
+   {
+      return unset_count * 32 > frontier;
+   }
+
+   bool preferSparse(const std::size_t unset_count, const std::size_t frontier) noexcept
+   {
+      return unset_count * 64 < frontier;
+   }
+}
+
+class panda::BitsetSparse::Cursor
+{
+   public:
+      explicit Cursor(const BitsetSparse& bitset_)
+      :
+         bitset(bitset_),
+         next(bitset_.unset.cbegin())
+      {
+      }
+      bool unset(const std::size_t index) noexcept
+      {
+         if ( index >= bitset.frontier )
+         {
+            return true;
+         }
+         if ( !bitset.is_sparse )
+         {
+            return ((bitset.words[index / digits] >> (index % digits)) & 1u) == 0;
+         }
+         while ( next != bitset.unset.cend() && *next < index )
+         {
+            ++next;
+         }
+         return next != bitset.unset.cend() && *next == index;
+      }
+   private:
+      const BitsetSparse& bitset;
+      std::vector<Position>::const_iterator next;
+};
+
+panda::BitsetSparse::BitsetSparse(const std::size_t bits)
+:
+   frontier(0),
+   unset(),
+   words(),
+   is_sparse(true)
+{
+   assert( bits > 0 );
+   assert( bits <= std::numeric_limits<Position>::max() );
+   static_cast<void>(bits);
+}
+
+bool panda::BitsetSparse::equals(const BitsetSparse& second, const std::size_t max) const noexcept
+{
+   return contains(second, max) && second.contains(*this, max);
+}
+
+bool panda::BitsetSparse::contains(const BitsetSparse& second, const std::size_t) const noexcept
+{
+   // the set bits of second are contained if the unset positions of this are unset in second.
+   Cursor cursor(second);
+   const auto below = forEachUnset(0, second.frontier, [&](const std::size_t index)
+   {
+      return cursor.unset(index);
+   });
+   return below && (frontier >= second.frontier || second.countUnset(frontier, second.frontier) == second.frontier - frontier);
+}
+
+std::size_t panda::BitsetSparse::count(const std::size_t) const noexcept
+{
+   return frontier - countUnset(0, frontier);
+}
+
+BitsetSparse panda::BitsetSparse::merge(const BitsetSparse& second, const std::size_t) const
+{
+   const auto& a = (frontier <= second.frontier) ? *this : second;
+   const auto& b = (frontier <= second.frontier) ? second : *this;
+   if ( !a.is_sparse && !b.is_sparse )
+   {
+      BitsetSparse result(b);
+      kernels::merge(result.words.data(), a.words.data(), a.words.size());
+      result.compress();
+      return result;
+   }
+   // unset in the union are the positions unset in both.
+   std::vector<Position> both;
+   Cursor cursor(b);
+   a.forEachUnset(0, a.frontier, [&](const std::size_t index)
+   {
+      if ( cursor.unset(index) )
+      {
+         both.push_back(static_cast<Position>(index));
+      }
+      return true;
+   });
+   b.forEachUnset(a.frontier, b.frontier, [&](const std::size_t index)
+   {
+      both.push_back(static_cast<Position>(index));
+      return true;
+   });
+   BitsetSparse result(*this);
+   result.assign(b.frontier, std::move(both));
+   return result;
+}
+
+void panda::BitsetSparse::set(const std::size_t index)
+{
+   assert( index < std::numeric_limits<Position>::max() );
+   if ( index >= frontier )
+   {
+      if ( is_sparse )
+      {
+         for ( auto position = frontier; position < index; ++position )
+         {
+            unset.push_back(static_cast<Position>(position));
+         }
+         frontier = index + 1;
+         if ( preferDense(unset.size(), frontier) )
+         {
+            assign(frontier, std::move(unset));
+            unset.clear();
+         }
+         return;
+      }
+      frontier = index + 1;
+      if ( wordCount(frontier) > words.size() )
+      {
+         words.resize(wordCount(frontier), 0);
+         // short prefixes are dense even with few unset bits, so the representation is reconsidered once per word.
+         compress();
+      }
+   }
+   if ( is_sparse )
+   {
+      const auto position = std::lower_bound(unset.begin(), unset.end(), static_cast<Position>(index));
+      if ( position != unset.end() && *position == index )
+      {
+         unset.erase(position);
+      }
+   }
+   else
+   {
+      words[index / digits] |= DataType(1) << (index % digits);
+   }
+}
+
+bool panda::BitsetSparse::test(const std::size_t index) const noexcept
+{
+   if ( index >= frontier )
+   {
+      return false;
+   }
+   if ( is_sparse )
+   {
+      return !std::binary_search(unset.cbegin(), unset.cend(), static_cast<Position>(index));
+   }
+   return ((words[index / digits] >> (index % digits)) & 1u) != 0;
+}
+
+bool panda::BitsetSparse::sparse() const noexcept
+{
+   return is_sparse;
+}
+
+std::size_t panda::BitsetSparse::unionCount(const BitsetSparse& first, const BitsetSparse& second, const std::size_t) noexcept
+{
+   const auto& a = (first.frontier <= second.frontier) ? first : second;
+   const auto& b = (first.frontier <= second.frontier) ? second : first;
+   if ( !a.is_sparse && !b.is_sparse )
+   {
+      return kernels::unionCount(a.words.data(), b.words.data(), a.words.size()) + kernels::count(b.words.data() + a.words.size(), b.words.size() - a.words.size());
+   }
+   // below the frontier of b, the bits not set in the union are the unset positions of a that are unset in b,
+   // and the unset positions of b from the frontier of a on.
+   std::size_t both = 0;
+   Cursor cursor(b);
+   a.forEachUnset(0, a.frontier, [&](const std::size_t index)
+   {
+      both += cursor.unset(index) ? 1 : 0;
+      return true;
+   });
+   return b.frontier - both - b.countUnset(a.frontier, b.frontier);
+}
+
+bool panda::BitsetSparse::unionContains(const BitsetSparse& first, const BitsetSparse& second, const BitsetSparse& inner, const std::size_t) noexcept
+{
+   const auto& a = (first.frontier <= second.frontier) ? first : second;
+   const auto& b = (first.frontier <= second.frontier) ? second : first;
+   if ( !a.is_sparse && !b.is_sparse && !inner.is_sparse && inner.frontier <= a.frontier )
+   {
+      return kernels::unionContains(a.words.data(), b.words.data(), inner.words.data(), inner.words.size());
+   }
+   // inner is contained in the union if every position unset in both a and b is unset in inner.
+   Cursor cursor_b(b);
+   Cursor cursor_inner(inner);
+   const auto below_a = a.forEachUnset(0, a.frontier, [&](const std::size_t index)
+   {
+      return !cursor_b.unset(index) || cursor_inner.unset(index);
+   });
+   if ( !below_a )
+   {
+      return false;
+   }
+   const auto below_b = b.forEachUnset(a.frontier, b.frontier, [&](const std::size_t index)
+   {
+      return cursor_inner.unset(index);
+   });
+   return below_b && (inner.frontier <= b.frontier || inner.countUnset(b.frontier, inner.frontier) == inner.frontier - b.frontier);
+}
+
+template <typename Function>
+bool panda::BitsetSparse::forEachUnset(const std::size_t first, const std::size_t last, Function function) const
+{
+   const auto end = std::min(last, frontier);
+   if ( first >= end )
+   {
+      return true;
+   }
+   if ( is_sparse )
+   {
+      for ( auto position = std::lower_bound(unset.cbegin(), unset.cend(), static_cast<Position>(first)); position != unset.cend() && *position < end; ++position )
+      {
+         if ( !function(static_cast<std::size_t>(*position)) )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+   for ( auto w = first / digits; w < wordCount(end); ++w )
+   {
+      auto zeros = ~words[w];
+      if ( w == first / digits )
+      {
+         zeros &= ~DataType(0) << (first % digits);
+      }
+      while ( zeros != 0 )
+      {
+         const auto index = w * digits + static_cast<std::size_t>(__builtin_ctzll(zeros));
+         if ( index >= end )
+         {
+            return true;
+         }
+         if ( !function(index) )
+         {
+            return false;
+         }
+         zeros &= zeros - 1;
+      }
+   }
+   return true;
+}
+
+std::size_t panda::BitsetSparse::countUnset(const std::size_t first, const std::size_t last) const noexcept
+{
+   if ( first >= last )
+   {
+      return 0;
+   }
+   const auto end = std::min(last, frontier);
+   const auto beyond = last - std::max(first, end);
+   if ( first >= end )
+   {
+      return beyond;
+   }
+   if ( is_sparse )
+   {
+      const auto lower = std::lower_bound(unset.cbegin(), unset.cend(), static_cast<Position>(first));
+      const auto upper = std::lower_bound(lower, unset.cend(), static_cast<Position>(end));
+      return beyond + static_cast<std::size_t>(upper - lower);
+   }
+   std::size_t set_bits = 0;
+   for ( auto w = first / digits; w < wordCount(end); ++w )
+   {
+      auto bits = words[w];
+      if ( w == first / digits )
+      {
+         bits &= ~DataType(0) << (first % digits);
+      }
+      if ( w == (end - 1) / digits && end % digits != 0 )
+      {
+         bits &= ~(~DataType(0) << (end % digits));
+      }
+      set_bits += static_cast<std::size_t>(popcount(bits));
+   }
+   return beyond + (end - first) - set_bits;
+}
+
+void panda::BitsetSparse::assign(const std::size_t frontier_, std::vector<Position> unset_)
+{
+   frontier = frontier_;
+   if ( !preferDense(unset_.size(), frontier) )
+   {
+      unset = std::move(unset_);
+      words.clear();
+      words.shrink_to_fit();
+      is_sparse = true;
+      return;
+   }
+   words.assign(wordCount(frontier), ~DataType(0));
+   if ( frontier % digits != 0 )
+   {
+      words.back() &= ~(~DataType(0) << (frontier % digits));
+   }
+   for ( const auto position : unset_ )
+   {
+      words[position / digits] &= ~(DataType(1) << (position % digits));
+   }
+   unset.clear();
+   unset.shrink_to_fit();
+   is_sparse = false;
+}
+
+void panda::BitsetSparse::compress()
+{
+   if ( is_sparse )
+   {
+      return;
+   }
+   const auto unset_count = countUnset(0, frontier);
+   if ( !preferSparse(unset_count, frontier) )
+   {
+      return;
+   }
+   std::vector<Position> positions;
+   positions.reserve(unset_count);
+   forEachUnset(0, frontier, [&](const std::size_t index)
+   {
+      positions.push_back(static_cast<Position>(index));
+      return true;
+   });
+   assign(frontier, std::move(positions));
+}
+
+std::vector<std::size_t> panda::unsetBits(const BitsetSparse& bitset, const std::size_t max)
+{
+   std::vector<std::size_t> result;
+   bitset.forEachUnset(0, max, [&](const std::size_t index)
+   {
+      result.push_back(index);
+      return true;
+   });
+   for ( auto index = bitset.frontier; index < max; ++index )
+   {
+      result.push_back(index);
+   }
+   return result;
+}
+
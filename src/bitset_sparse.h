@@ -0,0 +1,82 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitset_kernels.h"
+
+namespace panda
+{
+   /// A class for bitsets with few unset bits below the highest set bit, with the interface of BitsetVariableSize.
+   /// In Fourier-Motzkin elimination, a bitset holds the vertices a row is not incident to, so the unset bits are
+   /// the few vertices on the row and their number does not grow with the number of vertices.
+   ///
+   /// All bits from a frontier on are unset. Below the frontier, either the unset positions are stored as a sorted list
+   /// or, if this list would take more memory than the bits themselves, the bits are stored densely in words.
+   /// All operations are formulated on the unset positions, so that a sparse bitset is processed in time of its list.
+   class BitsetSparse
+   {
+      public:
+         static std::size_t unionCount(const BitsetSparse&, const BitsetSparse&, const std::size_t) noexcept;
+         static bool unionContains(const BitsetSparse&, const BitsetSparse&, const BitsetSparse&, const std::size_t) noexcept;
+         /// Underlying data type of the dense representation.
+         using DataType = kernels::Word;
+         /// Constructor: argument denotes number of bits.
+         BitsetSparse(const std::size_t);
+         /// Default copy constructor.
+         BitsetSparse(const BitsetSparse&) = default;
+         /// Default move constructor.
+         BitsetSparse(BitsetSparse&&) = default;
+         /// Default copy assignment operator.
+         BitsetSparse& operator=(const BitsetSparse&) = default;
+         /// Default move assignment operator.
+         BitsetSparse& operator=(BitsetSparse&&) = default;
+         /// Comparison (equality) with another Bitset with a hint of highest set bit.
+         bool equals(const BitsetSparse&, const std::size_t) const noexcept;
+         /// Checks if the passed Bitset is contained in this (with hint of highest set bit).
+         bool contains(const BitsetSparse&, const std::size_t) const noexcept;
+         /// Returns the union with a second bitset with a hint of highest set bit.
+         BitsetSparse merge(const BitsetSparse&, const std::size_t) const;
+         /// Returns the number of 1s in the bitset with a hint of highest set bit.
+         std::size_t count(const std::size_t) const noexcept;
+         /// Sets the i^th bit.
+         void set(const std::size_t);
+         /// Returns the i^th bit.
+         bool test(const std::size_t) const noexcept;
+         /// Checks if the unset positions are stored as a list.
+         bool sparse() const noexcept;
+         friend std::vector<std::size_t> unsetBits(const BitsetSparse&, const std::size_t);
+      private:
+         using Position = uint32_t;
+         /// Answers whether positions are unset for non-decreasing positions in amortized constant time.
+         class Cursor;
+         /// Calls the function for the unset positions in [first, last) below the frontier in increasing order
+         /// until it returns false. Returns false if the function did.
+         template <typename Function>
+         bool forEachUnset(const std::size_t, const std::size_t, Function) const;
+         /// Returns the number of unset positions in [first, last).
+         std::size_t countUnset(const std::size_t, const std::size_t) const noexcept;
+         /// Replaces the contents by the given frontier and sorted unset positions below it, in the cheaper representation.
+         void assign(const std::size_t, std::vector<Position>);
+         /// Switches to the cheaper representation.
+         void compress();
+      private:
+         std::size_t frontier;
+         /// Sorted unset positions below the frontier, if sparse.
+         std::vector<Position> unset;
+         /// Bits below the frontier, if dense.
+         std::vector<DataType> words;
+         bool is_sparse;
+   };
+
+   /// Returns the positions in [0, max) that are not set, enumerating the stored positions instead of testing every bit.
+   std::vector<std::size_t> unsetBits(const BitsetSparse&, const std::size_t);
+}
+
@@ -4,12 +4,11 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
-#include <array>
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
 #include "bitset_variable_size.h"
-#include "popcount.h"
 
 using namespace panda;
 
@@ -23,44 +22,25 @@ panda::BitsetVariableSize::BitsetVariableSize(const std::size_t bits)
 bool panda::BitsetVariableSize::equals(const BitsetVariableSize& second, const std::size_t max) const noexcept
 {
    assert( data.size() == second.data.size() );
-   const auto end = data.cbegin() + 1 + (max - 1) / std::numeric_limits<DataType>::digits;
-   return std::equal(data.cbegin(), end, second.data.cbegin());
+   return std::equal(data.cbegin(), data.cbegin() + static_cast<std::ptrdiff_t>(words(max)), second.data.cbegin());
 }
 
 bool panda::BitsetVariableSize::contains(const BitsetVariableSize& second, const std::size_t max) const noexcept
 {
    assert( data.size() == second.data.size() );
-   const auto end = 1u + (max - 1) / std::numeric_limits<DataType>::digits;
-   for ( std::size_t i = 0; i < end; ++i )
-   {
-      if ( (data[i] & second.data[i]) != second.data[i] )
-      {
-         return false;
-      }
-   }
-   return true;
+   return kernels::contains(data.data(), second.data.data(), words(max));
 }
 
 std::size_t panda::BitsetVariableSize::count(const std::size_t max) const noexcept
 {
-   std::size_t total{0};
-   const auto end = data.cbegin() + 1 + (max - 1) / std::numeric_limits<DataType>::digits;
-   for ( auto it = data.cbegin(); it != end; ++it )
-   {
-      total += static_cast<std::size_t>(popcount(*it));
-   }
-   return total;
+   return kernels::count(data.data(), words(max));
 }
 
 BitsetVariableSize panda::BitsetVariableSize::merge(const BitsetVariableSize& second, const std::size_t max) const noexcept
 {
    assert( data.size() == second.data.size() );
    BitsetVariableSize result = *this;
-   const std::size_t end = 1 + (max - 1) / std::numeric_limits<DataType>::digits;
-   for ( std::size_t i = 0; i < end; ++i )
-   {
-      result.data[i] |= second.data[i];
-   }
+   kernels::merge(result.data.data(), second.data.data(), words(max));
    return result;
 }
 
@@ -71,29 +51,24 @@ void panda::BitsetVariableSize::set(const std::size_t index) noexcept
    data[index / std::numeric_limits<DataType>::digits] |= mask;
 }
 
+bool panda::BitsetVariableSize::test(const std::size_t index) const noexcept
+{
+   const DataType mask = static_cast<DataType>(1u) << (index % std::numeric_limits<DataType>::digits);
+   assert(index / std::numeric_limits<DataType>::digits < data.size() );
+   return (data[index / std::numeric_limits<DataType>::digits] & mask) != 0;
+}
+
 std::size_t panda::BitsetVariableSize::unionCount(const BitsetVariableSize& a, const BitsetVariableSize& b, const std::size_t max) noexcept
 {
-   std::size_t total{0};
-   const auto end_a = a.data.cbegin() + 1 + (max - 1) / std::numeric_limits<BitsetVariableSize::DataType>::digits;
-   for ( auto ita = a.data.cbegin(), itb = b.data.cbegin(); ita != end_a; ++ita, ++itb )
-   {
-      total += static_cast<std::size_t>(popcount(*ita));
-      total += static_cast<std::size_t>(popcount(*itb));
-      total -= static_cast<std::size_t>(popcount((*ita) & (*itb)));
-   }
-   return total;
+   return kernels::unionCount(a.data.data(), b.data.data(), words(max));
 }
 
 bool panda::BitsetVariableSize::unionContains(const BitsetVariableSize& a, const BitsetVariableSize& b, const BitsetVariableSize& inner, const std::size_t max) noexcept
 {
-   const auto end = 1u + (max - 1) / std::numeric_limits<BitsetVariableSize::DataType>::digits;
-   for ( std::size_t i = 0; i < end; ++i )
-   {
-      if ( ((a.data[i] | b.data[i]) & inner.data[i]) != inner.data[i] )
-      {
-         return false;
-      }
-   }
-   return true;
+   return kernels::unionContains(a.data.data(), b.data.data(), inner.data.data(), words(max));
 }
 
+std::size_t panda::BitsetVariableSize::words(const std::size_t max) noexcept
+{
+   return 1 + (max - 1) / std::numeric_limits<DataType>::digits;
+}
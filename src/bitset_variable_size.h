@@ -10,6 +10,8 @@
 #include <cstdint>
 #include <vector>
 
+#include "bitset_kernels.h"
+
 namespace panda
 {
    /// A class for variable size bitsets that provides checks for equality and containment, as well as utility functions such as merging.
@@ -19,7 +21,7 @@ namespace panda
          static std::size_t unionCount(const BitsetVariableSize&, const BitsetVariableSize&, const std::size_t) noexcept;
          static bool unionContains(const BitsetVariableSize&, const BitsetVariableSize&, const BitsetVariableSize&, const std::size_t) noexcept;
          /// Underlying data type.
-         using DataType = uint32_t;
+         using DataType = kernels::Word;
          /// Constructor: argument denotes number of bits.
          BitsetVariableSize(const std::size_t);
          /// Default copy constructor.
@@ -40,6 +42,11 @@ namespace panda
          std::size_t count(const std::size_t) const noexcept;
          /// Sets the i^th bit.
          void set(const std::size_t) noexcept;
+         /// Returns the i^th bit.
+         bool test(const std::size_t) const noexcept;
+      private:
+         /// Number of words to process for a hint of highest set bit.
+         static std::size_t words(const std::size_t) noexcept;
       private:
          std::vector<DataType> data;
    };
@@ -0,0 +1,63 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.h"
+
+namespace panda
+{
+   /// Matrix stored row-major in a single block with a fixed stride (the number of columns).
+   /// Unlike Matrix, rows are not separate heap blocks, so walking rows or columns does not chase pointers.
+   /// A column-major copy is obtained by transposition.
+   template <typename Integer>
+   class DenseMatrix
+   {
+      public:
+         /// Constructor for an empty matrix.
+         DenseMatrix();
+         /// Constructor for a matrix of zeros.
+         DenseMatrix(const std::size_t, const std::size_t);
+         /// Copies a matrix. All rows need to have the same size.
+         explicit DenseMatrix(const Matrix<Integer>&);
+         /// Returns the number of rows.
+         std::size_t rows() const noexcept;
+         /// Returns the number of columns.
+         std::size_t columns() const noexcept;
+         /// Checks if the matrix has no rows.
+         bool empty() const noexcept;
+         /// Returns a pointer to the first entry of a row.
+         Integer* operator[](const std::size_t) noexcept;
+         /// Returns a pointer to the first entry of a row.
+         const Integer* operator[](const std::size_t) const noexcept;
+         /// Returns a copy of a row.
+         Row<Integer> row(const std::size_t) const;
+         /// Changes the number of rows. New rows are zero.
+         void resizeRows(const std::size_t);
+         /// Reserves memory for the given number of rows.
+         void reserveRows(const std::size_t);
+         /// Removes the rows [first, last).
+         void eraseRows(const std::size_t, const std::size_t);
+         /// Removes a column.
+         void eraseColumn(const std::size_t);
+         /// Swaps the contents of two rows.
+         void swapRows(const std::size_t, const std::size_t) noexcept;
+         /// Returns the transposition.
+         DenseMatrix transposed() const;
+         /// Copies the matrix into the row-based format.
+         Matrix<Integer> toMatrix() const;
+      private:
+         std::size_t row_count;
+         std::size_t column_count;
+         std::vector<Integer> data;
+   };
+}
+
+#include "dense_matrix.tpp"
+
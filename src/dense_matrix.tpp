@@ -0,0 +1,154 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+template <typename Integer>
+panda::DenseMatrix<Integer>::DenseMatrix()
+:
+   row_count(0),
+   column_count(0),
+   data()
+{
+}
+
+template <typename Integer>
+panda::DenseMatrix<Integer>::DenseMatrix(const std::size_t rows_, const std::size_t columns_)
+:
+   row_count(rows_),
+   column_count(columns_),
+   data(rows_ * columns_, Integer(0))
+{
+}
+
+template <typename Integer>
+panda::DenseMatrix<Integer>::DenseMatrix(const Matrix<Integer>& matrix)
+:
+   row_count(matrix.size()),
+   column_count(matrix.empty() ? 0 : matrix.front().size()),
+   data()
+{
+   data.reserve(row_count * column_count);
+   for ( const auto& r : matrix )
+   {
+      assert( r.size() == column_count );
+      data.insert(data.end(), r.cbegin(), r.cend());
+   }
+}
+
+template <typename Integer>
+std::size_t panda::DenseMatrix<Integer>::rows() const noexcept
+{
+   return row_count;
+}
+
+template <typename Integer>
+std::size_t panda::DenseMatrix<Integer>::columns() const noexcept
+{
+   return column_count;
+}
+
+template <typename Integer>
+bool panda::DenseMatrix<Integer>::empty() const noexcept
+{
+   return row_count == 0;
+}
+
+template <typename Integer>
+Integer* panda::DenseMatrix<Integer>::operator[](const std::size_t r) noexcept
+{
+   assert( r < row_count );
+   return data.data() + r * column_count;
+}
+
+template <typename Integer>
+const Integer* panda::DenseMatrix<Integer>::operator[](const std::size_t r) const noexcept
+{
+   assert( r < row_count );
+   return data.data() + r * column_count;
+}
+
+template <typename Integer>
+panda::Row<Integer> panda::DenseMatrix<Integer>::row(const std::size_t r) const
+{
+   const auto first = (*this)[r];
+   return Row<Integer>(first, first + column_count);
+}
+
+template <typename Integer>
+void panda::DenseMatrix<Integer>::resizeRows(const std::size_t rows_)
+{
+   data.resize(rows_ * column_count, Integer(0));
+   row_count = rows_;
+}
+
+template <typename Integer>
+void panda::DenseMatrix<Integer>::reserveRows(const std::size_t rows_)
+{
+   data.reserve(rows_ * column_count);
+}
+
+template <typename Integer>
+void panda::DenseMatrix<Integer>::eraseRows(const std::size_t first, const std::size_t last)
+{
+   assert( first <= last && last <= row_count );
+   using Difference = typename std::vector<Integer>::difference_type;
+   data.erase(data.begin() + static_cast<Difference>(first * column_count), data.begin() + static_cast<Difference>(last * column_count));
+   row_count -= last - first;
+}
+
+template <typename Integer>
+void panda::DenseMatrix<Integer>::eraseColumn(const std::size_t column)
+{
+   assert( column < column_count );
+   std::size_t target = column;
+   for ( std::size_t source = column + 1; source < data.size(); ++source )
+   {
+      if ( source % column_count != column )
+      {
+         data[target] = std::move(data[source]);
+         ++target;
+      }
+   }
+   --column_count;
+   data.resize(row_count * column_count);
+}
+
+template <typename Integer>
+void panda::DenseMatrix<Integer>::swapRows(const std::size_t a, const std::size_t b) noexcept
+{
+   std::swap_ranges((*this)[a], (*this)[a] + column_count, (*this)[b]);
+}
+
+template <typename Integer>
+panda::DenseMatrix<Integer> panda::DenseMatrix<Integer>::transposed() const
+{
+   DenseMatrix<Integer> result(column_count, row_count);
+   for ( std::size_t r = 0; r < row_count; ++r )
+   {
+      const auto source = (*this)[r];
+      for ( std::size_t c = 0; c < column_count; ++c )
+      {
+         result.data[c * row_count + r] = source[c];
+      }
+   }
+   return result;
+}
+
+template <typename Integer>
+panda::Matrix<Integer> panda::DenseMatrix<Integer>::toMatrix() const
+{
+   Matrix<Integer> matrix;
+   matrix.reserve(row_count);
+   for ( std::size_t r = 0; r < row_count; ++r )
+   {
+      matrix.push_back(row(r));
+   }
+   return matrix;
+}
+
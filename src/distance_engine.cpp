@@ -0,0 +1,339 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_DISTANCE_ENGINE
+#include "distance_engine.h"
+#undef COMPILE_TEMPLATE_DISTANCE_ENGINE
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace panda;
+
+namespace
+{
+   using Magnitude = uint64_t;
+   /// Number of vertices whose distances are evaluated at once by the queries. The block stays in the first level cache.
+   constexpr std::size_t block_size = 256;
+   /// Returns the vertices as columns of a matrix.
+   template <typename Integer>
+   DenseMatrix<Integer> columnMajor(const Vertices<Integer>&);
+   /// Returns the absolute value of a fixed width integer.
+   template <typename Integer>
+   Magnitude magnitude(const Integer) noexcept;
+   /// Returns the largest absolute value of each row.
+   template <typename Integer>
+   std::vector<Magnitude> rowMagnitudes(const DenseMatrix<Integer>&, std::true_type);
+   /// Arbitrary precision and checked integers need no bounds.
+   template <typename Integer>
+   std::vector<Magnitude> rowMagnitudes(const DenseMatrix<Integer>&, std::false_type);
+   /// Returns the largest factor of each magnitude whose product with it is at most the largest value of the integer type.
+   template <typename Integer>
+   std::vector<Magnitude> largestFactors(const std::vector<Magnitude>&, std::true_type);
+   /// Arbitrary precision and checked integers need no bounds.
+   template <typename Integer>
+   std::vector<Magnitude> largestFactors(const std::vector<Magnitude>&, std::false_type);
+   /// Checks if no partial sum of the distance to the inequality can overflow for any vertex,
+   /// given the largest absolute value of each column of the vertices and the largest factors thereof.
+   template <typename Integer>
+   bool bounded(const Inequality<Integer>&, const std::vector<Magnitude>&, const std::vector<Magnitude>&, std::true_type) noexcept;
+   /// BigInteger cannot overflow and SafeInteger checks each operation itself.
+   template <typename Integer>
+   bool bounded(const Inequality<Integer>&, const std::vector<Magnitude>&, const std::vector<Magnitude>&, std::false_type) noexcept;
+   /// Writes the distances of the vertices [first, last), given column by column, to the inequality. The arithmetic is unchecked.
+   template <typename Integer>
+   void distanceKernel(const DenseMatrix<Integer>&, const Inequality<Integer>&, const std::size_t, const std::size_t, Integer*);
+   /// Same as distanceKernel, but each operation is checked. Throws std::overflow_error.
+   template <typename Integer>
+   void checkedDistanceKernel(const DenseMatrix<Integer>&, const Inequality<Integer>&, const std::size_t, const std::size_t, Integer*);
+   /// Calls the unchecked kernel if the flag is set and the checked kernel otherwise.
+   template <typename Integer>
+   void dispatch(const DenseMatrix<Integer>&, const Inequality<Integer>&, const bool, const std::size_t, const std::size_t, Integer*, std::true_type);
+   /// Calls the unchecked kernel, as all operations of these types are safe.
+   template <typename Integer>
+   void dispatch(const DenseMatrix<Integer>&, const Inequality<Integer>&, const bool, const std::size_t, const std::size_t, Integer*, std::false_type);
+}
+
+template <typename Integer>
+panda::DistanceEngine<Integer>::DistanceEngine(const Vertices<Integer>& vertices)
+:
+   columns(columnMajor(vertices)),
+   magnitudes(rowMagnitudes(columns, std::is_integral<Integer>{})),
+   factors(largestFactors<Integer>(magnitudes, std::is_integral<Integer>{}))
+{
+}
+
+template <typename Integer>
+std::size_t panda::DistanceEngine<Integer>::size() const noexcept
+{
+   return columns.columns();
+}
+
+template <typename Integer>
+std::vector<Integer> panda::DistanceEngine<Integer>::distances(const Inequality<Integer>& inequality) const
+{
+   std::vector<Integer> result(size());
+   evaluate(inequality, bounded(inequality), 0, size(), result.data());
+   return result;
+}
+
+template <typename Integer>
+DenseMatrix<Integer> panda::DistanceEngine<Integer>::distances(const Inequalities<Integer>& inequalities) const
+{
+   DenseMatrix<Integer> result(inequalities.size(), size());
+   for ( std::size_t k = 0; k < inequalities.size(); ++k )
+   {
+      evaluate(inequalities[k], bounded(inequalities[k]), 0, size(), result[k]);
+   }
+   return result;
+}
+
+template <typename Integer>
+std::size_t panda::DistanceEngine<Integer>::furthest(const Inequality<Integer>& inequality) const
+{
+   return extremal(inequality, std::greater<Integer>{});
+}
+
+template <typename Integer>
+std::size_t panda::DistanceEngine<Integer>::nearest(const Inequality<Integer>& inequality) const
+{
+   return extremal(inequality, std::less<Integer>{});
+}
+
+template <typename Integer>
+std::vector<std::size_t> panda::DistanceEngine<Integer>::zeroDistance(const Inequality<Integer>& inequality) const
+{
+   const auto unchecked = bounded(inequality);
+   std::array<Integer, block_size> block;
+   std::vector<std::size_t> indices;
+   for ( std::size_t first = 0; first < size(); first += block_size )
+   {
+      const auto count = std::min(block_size, size() - first);
+      evaluate(inequality, unchecked, first, first + count, block.data());
+      for ( std::size_t i = 0; i < count; ++i )
+      {
+         if ( block[i] == 0 )
+         {
+            indices.push_back(first + i);
+         }
+      }
+   }
+   return indices;
+}
+
+template <typename Integer>
+bool panda::DistanceEngine<Integer>::bounded(const Inequality<Integer>& inequality) const noexcept
+{
+   return ::bounded(inequality, magnitudes, factors, std::is_integral<Integer>{});
+}
+
+template <typename Integer>
+void panda::DistanceEngine<Integer>::evaluate(const Inequality<Integer>& inequality, const bool unchecked, const std::size_t first, const std::size_t last, Integer* const result) const
+{
+   assert( inequality.size() == columns.rows() );
+   assert( first <= last && last <= size() );
+   dispatch(columns, inequality, unchecked, first, last, result, std::is_integral<Integer>{});
+}
+
+template <typename Integer>
+template <typename Better>
+std::size_t panda::DistanceEngine<Integer>::extremal(const Inequality<Integer>& inequality, Better better) const
+{
+   assert( size() > 0 );
+   const auto unchecked = bounded(inequality);
+   std::array<Integer, block_size> block;
+   Integer best_value(0);
+   std::size_t best_index = 0;
+   for ( std::size_t first = 0; first < size(); first += block_size )
+   {
+      const auto count = std::min(block_size, size() - first);
+      evaluate(inequality, unchecked, first, first + count, block.data());
+      // the best value of a block is a reduction without branches, its first position is only searched if it improves.
+      auto value = block[0];
+      for ( std::size_t i = 1; i < count; ++i )
+      {
+         value = better(block[i], value) ? block[i] : value;
+      }
+      if ( first == 0 || better(value, best_value) )
+      {
+         best_value = value;
+         best_index = first + static_cast<std::size_t>(std::find(block.cbegin(), block.cbegin() + count, value) - block.cbegin());
+      }
+   }
+   return best_index;
+}
+
+namespace
+{
+   template <typename Integer>
+   DenseMatrix<Integer> columnMajor(const Vertices<Integer>& vertices)
+   {
+      DenseMatrix<Integer> result(vertices.empty() ? 0 : vertices.front().size(), vertices.size());
+      for ( std::size_t i = 0; i < vertices.size(); ++i )
+      {
+         assert( vertices[i].size() == result.rows() );
+         for ( std::size_t j = 0; j < result.rows(); ++j )
+         {
+            result[j][i] = vertices[i][j];
+         }
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   Magnitude magnitude(const Integer value) noexcept
+   {
+      // the minimum of a two's complement type has no negation in the type itself.
+      return (value < 0) ? Magnitude(-(value + 1)) + 1 : Magnitude(value);
+   }
+
+   template <typename Integer>
+   std::vector<Magnitude> rowMagnitudes(const DenseMatrix<Integer>& matrix, std::true_type)
+   {
+      std::vector<Magnitude> result(matrix.rows(), 0);
+      for ( std::size_t r = 0; r < matrix.rows(); ++r )
+      {
+         const auto row = matrix[r];
+         for ( std::size_t c = 0; c < matrix.columns(); ++c )
+         {
+            result[r] = std::max(result[r], magnitude(row[c]));
+         }
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   std::vector<Magnitude> rowMagnitudes(const DenseMatrix<Integer>&, std::false_type)
+   {
+      return std::vector<Magnitude>();
+   }
+
+   template <typename Integer>
+   std::vector<Magnitude> largestFactors(const std::vector<Magnitude>& column_magnitudes, std::true_type)
+   {
+      const auto limit = static_cast<Magnitude>(std::numeric_limits<Integer>::max());
+      std::vector<Magnitude> result;
+      result.reserve(column_magnitudes.size());
+      for ( const auto value : column_magnitudes )
+      {
+         result.push_back((value == 0) ? std::numeric_limits<Magnitude>::max() : limit / value);
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   std::vector<Magnitude> largestFactors(const std::vector<Magnitude>&, std::false_type)
+   {
+      return std::vector<Magnitude>();
+   }
+
+   template <typename Integer>
+   bool bounded(const Inequality<Integer>& inequality, const std::vector<Magnitude>& column_magnitudes, const std::vector<Magnitude>& factors, std::true_type) noexcept
+   {
+      assert( inequality.size() == column_magnitudes.size() );
+      const auto limit = static_cast<Magnitude>(std::numeric_limits<Integer>::max());
+      Magnitude bound = 0;
+      for ( std::size_t j = 0; j < inequality.size(); ++j )
+      {
+         // the divisions are done once per vertex set by largestFactors.
+         const auto coefficient = magnitude(inequality[j]);
+         if ( coefficient > factors[j] )
+         {
+            return false;
+         }
+         const auto term = coefficient * column_magnitudes[j];
+         if ( term > limit - bound )
+         {
+            return false;
+         }
+         bound += term;
+      }
+      return true;
+   }
+
+   template <typename Integer>
+   bool bounded(const Inequality<Integer>&, const std::vector<Magnitude>&, const std::vector<Magnitude>&, std::false_type) noexcept
+   {
+      return true;
+   }
+
+   template <typename Integer>
+   void distanceKernel(const DenseMatrix<Integer>& columns, const Inequality<Integer>& inequality, const std::size_t first, const std::size_t last, Integer* const result)
+   {
+      const auto count = last - first;
+      std::fill(result, result + count, Integer(0));
+      for ( std::size_t j = 0; j < columns.rows(); ++j )
+      {
+         const auto coefficient = inequality[j];
+         if ( coefficient == 0 )
+         {
+            continue;
+         }
+         // contiguous in both arrays without a dependency between iterations, hence vectorized.
+         const auto column = columns[j] + first;
+         for ( std::size_t i = 0; i < count; ++i )
+         {
+            result[i] -= coefficient * column[i];
+         }
+      }
+   }
+
+   template <typename Integer>
+   void checkedDistanceKernel(const DenseMatrix<Integer>& columns, const Inequality<Integer>& inequality, const std::size_t first, const std::size_t last, Integer* const result)
+   {
+      using Limits = std::numeric_limits<Integer>;
+      const auto overflow = []()
+      {
+         throw std::overflow_error("Distance computation did overflow.");
+      };
+      const auto count = last - first;
+      std::fill(result, result + count, Integer(0));
+      for ( std::size_t j = 0; j < columns.rows(); ++j )
+      {
+         const auto a = inequality[j];
+         const auto column = columns[j] + first;
+         for ( std::size_t i = 0; i < count; ++i )
+         {
+            const auto b = column[i];
+            if ( (a > 0) ? ((b > 0) ? a > Limits::max() / b : b < Limits::min() / a)
+                         : ((b > 0) ? a < Limits::min() / b : a != 0 && b < Limits::max() / a) )
+            {
+               overflow();
+            }
+            const auto product = static_cast<Integer>(a * b);
+            if ( (product < 0 && result[i] > Limits::max() + product) || (product > 0 && result[i] < Limits::min() + product) )
+            {
+               overflow();
+            }
+            result[i] = static_cast<Integer>(result[i] - product);
+         }
+      }
+   }
+
+   template <typename Integer>
+   void dispatch(const DenseMatrix<Integer>& columns, const Inequality<Integer>& inequality, const bool unchecked, const std::size_t first, const std::size_t last, Integer* const result, std::true_type)
+   {
+      if ( unchecked )
+      {
+         distanceKernel(columns, inequality, first, last, result);
+      }
+      else
+      {
+         checkedDistanceKernel(columns, inequality, first, last, result);
+      }
+   }
+
+   template <typename Integer>
+   void dispatch(const DenseMatrix<Integer>& columns, const Inequality<Integer>& inequality, const bool, const std::size_t first, const std::size_t last, Integer* const result, std::false_type)
+   {
+      distanceKernel(columns, inequality, first, last, result);
+   }
+}
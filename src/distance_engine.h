@@ -0,0 +1,62 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "dense_matrix.h"
+#include "matrix.h"
+#include "row.h"
+
+namespace panda
+{
+   /// Evaluates inequalities against all vertices of a fixed set at once.
+   /// The vertices are stored column by column, so the distances of all vertices are accumulated one coefficient
+   /// at a time in a loop over contiguous memory, which compilers vectorize for the fixed width integer types.
+   /// Vertices are referred to by their index in the set the engine was constructed from.
+   template <typename Integer>
+   class DistanceEngine
+   {
+      public:
+         /// Constructor taking the vertices. All vertices need to have the same size.
+         explicit DistanceEngine(const Vertices<Integer>&);
+         /// Returns the number of vertices.
+         std::size_t size() const noexcept;
+         /// Returns the distances of all vertices to a face defined by an inequality, see algorithm::distance.
+         /// Throws std::overflow_error if a distance does not fit into the integer type.
+         std::vector<Integer> distances(const Inequality<Integer>&) const;
+         /// Returns the distances of all vertices to each of the inequalities, one row per inequality.
+         DenseMatrix<Integer> distances(const Inequalities<Integer>&) const;
+         /// Returns the index of the first vertex that maximizes the distance function.
+         /// Throws std::overflow_error if a distance does not fit into the integer type.
+         std::size_t furthest(const Inequality<Integer>&) const;
+         /// Returns the index of the first vertex that minimizes the distance function.
+         /// Throws std::overflow_error if a distance does not fit into the integer type.
+         std::size_t nearest(const Inequality<Integer>&) const;
+         /// Returns the indices of all vertices on the face (distance zero) in ascending order.
+         std::vector<std::size_t> zeroDistance(const Inequality<Integer>&) const;
+      private:
+         /// Upper bound of the absolute value of an entry.
+         using Magnitude = uint64_t;
+      private:
+         DenseMatrix<Integer> columns;
+         std::vector<Magnitude> magnitudes; // largest absolute value per column, empty for types without overflow.
+         std::vector<Magnitude> factors; // largest absolute value of a coefficient per column whose products fit.
+      private:
+         /// Checks if the distances to the inequality can be evaluated without checking each operation for overflow.
+         bool bounded(const Inequality<Integer>&) const noexcept;
+         /// Writes the distances of the vertices [first, last) to the inequality, unchecked if the second argument is true.
+         void evaluate(const Inequality<Integer>&, const bool, const std::size_t, const std::size_t, Integer*) const;
+         /// Returns the index of the first vertex whose distance is better than or equal to all others.
+         template <typename Better>
+         std::size_t extremal(const Inequality<Integer>&, Better) const;
+   };
+}
+
+#include "distance_engine.eti"
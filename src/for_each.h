@@ -0,0 +1,17 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace panda
+{
+   /// Calls a function for all indices in [0, size) and returns after all calls finished, possibly running them concurrently.
+   using ForEach = std::function<void(std::size_t, const std::function<void(std::size_t)>&)>;
+}
+
@@ -0,0 +1,33 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "fourier_motzkin_checkpoint.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+using namespace panda;
+
+std::uint64_t panda::implementation::fingerprint(const std::string& bytes) noexcept
+{
+   std::uint64_t hash = 14695981039346656037ull;
+   for ( const auto byte : bytes )
+   {
+      hash ^= static_cast<unsigned char>(byte);
+      hash *= 1099511628211ull;
+   }
+   return hash;
+}
+
+void panda::implementation::replaceFile(const std::string& temporary, const std::string& target)
+{
+   // rename is atomic on POSIX file systems: readers see either the old or the new checkpoint.
+   if ( std::rename(temporary.c_str(), target.c_str()) != 0 )
+   {
+      throw std::runtime_error("Cannot replace checkpoint file \"" + target + "\".");
+   }
+}
+
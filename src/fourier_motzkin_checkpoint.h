@@ -0,0 +1,89 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "big_integer.h"
+#include "dense_matrix.h"
+#include "joining_thread.h"
+#include "matrix.h"
+#include "safe_integer.h"
+
+namespace panda
+{
+   /// Writes a fixed width integer to a binary stream.
+   template <typename Integer>
+   typename std::enable_if<std::is_arithmetic<Integer>::value>::type writeBinary(std::ostream&, const Integer&);
+   /// Reads a fixed width integer from a binary stream.
+   template <typename Integer>
+   typename std::enable_if<std::is_arithmetic<Integer>::value>::type readBinary(std::istream&, Integer&);
+
+   /// State of phase two of the Fourier-Motzkin elimination before a step.
+   template <typename Integer, typename Bitset>
+   struct FourierMotzkinState
+   {
+      /// Identifies the input and the settings the state belongs to.
+      std::uint64_t fingerprint;
+      /// Index of the next vertex to insert.
+      std::size_t step;
+      /// Learned fraction of adjacent pairs of adaptive insertion orders.
+      double survival;
+      /// Vertices in their current order.
+      Vertices<Integer> vertices;
+      /// Current system.
+      DenseMatrix<Integer> matrix;
+      /// Non-incident vertices of each row of the system.
+      std::vector<Bitset> R;
+   };
+
+   /// Fingerprint of the initial state of phase two and the parameters influencing its course.
+   template <typename Integer>
+   std::uint64_t fourierMotzkinFingerprint(const DenseMatrix<Integer>&, const Vertices<Integer>&, const int);
+   /// Writes a state to the file. The file is replaced atomically by writing a temporary file first.
+   template <typename Integer, typename Bitset>
+   void writeCheckpoint(const std::string&, const FourierMotzkinState<Integer, Bitset>&);
+   /// Reads a state from the file. Throws if the file is corrupt or does not match the fingerprint.
+   template <typename Integer, typename Bitset>
+   FourierMotzkinState<Integer, Bitset> readCheckpoint(const std::string&, const std::uint64_t);
+
+   /// Writes checkpoints on a background thread, so that the elimination continues while a state is written.
+   /// A checkpoint is skipped if the previous one is still being written.
+   template <typename Integer, typename Bitset>
+   class CheckpointWriter
+   {
+      public:
+         /// Constructor taking the name of the checkpoint file.
+         explicit CheckpointWriter(std::string);
+         /// Checks if the previous checkpoint is completely written.
+         bool idle() const noexcept;
+         /// Starts writing the state. Requires idle().
+         void write(FourierMotzkinState<Integer, Bitset>);
+      private:
+         std::string filename;
+         std::shared_ptr<std::atomic<bool>> busy;
+         std::unique_ptr<JoiningThread> thread;
+   };
+
+   namespace implementation
+   {
+      /// FNV-1a hash of a sequence of bytes.
+      std::uint64_t fingerprint(const std::string&) noexcept;
+      /// Replaces the target file by the temporary file.
+      void replaceFile(const std::string&, const std::string&);
+   }
+}
+
+#include "fourier_motzkin_checkpoint.tpp"
+
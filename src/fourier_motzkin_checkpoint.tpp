@@ -0,0 +1,226 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+namespace panda
+{
+   namespace implementation
+   {
+      /// Marks the begin of a checkpoint file and its format version.
+      constexpr char checkpoint_magic[] = "PANDACP1";
+   }
+}
+
+template <typename Integer>
+typename std::enable_if<std::is_arithmetic<Integer>::value>::type panda::writeBinary(std::ostream& stream, const Integer& value)
+{
+   stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename Integer>
+typename std::enable_if<std::is_arithmetic<Integer>::value>::type panda::readBinary(std::istream& stream, Integer& value)
+{
+   stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+template <typename Integer>
+std::uint64_t panda::fourierMotzkinFingerprint(const DenseMatrix<Integer>& matrix, const Vertices<Integer>& vertices, const int order)
+{
+   std::ostringstream bytes;
+   bytes << typeid(Integer).name() << ' ' << order << ' ' << matrix.rows() << ' ' << matrix.columns() << ' ' << vertices.size() << ' ';
+   for ( std::size_t j = 0; j < matrix.rows(); ++j )
+   {
+      std::for_each(matrix[j], matrix[j] + matrix.columns(), [&bytes](const Integer& entry) { writeBinary(bytes, entry); });
+   }
+   for ( const auto& vertex : vertices )
+   {
+      for ( const auto& entry : vertex )
+      {
+         writeBinary(bytes, entry);
+      }
+   }
+   return implementation::fingerprint(bytes.str());
+}
+
+template <typename Integer, typename Bitset>
+void panda::writeCheckpoint(const std::string& filename, const FourierMotzkinState<Integer, Bitset>& state)
+{
+   const auto temporary = filename + ".tmp";
+   {
+      std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+      if ( !file )
+      {
+         throw std::runtime_error("Cannot open checkpoint file \"" + temporary + "\".");
+      }
+      file.write(implementation::checkpoint_magic, sizeof(implementation::checkpoint_magic) - 1);
+      const auto n = static_cast<std::uint64_t>(state.vertices.size());
+      const auto d = static_cast<std::uint64_t>(state.matrix.columns());
+      const auto rows = static_cast<std::uint64_t>(state.matrix.rows());
+      writeBinary(file, state.fingerprint);
+      writeBinary(file, static_cast<std::uint64_t>(state.step));
+      writeBinary(file, state.survival);
+      writeBinary(file, n);
+      writeBinary(file, d);
+      writeBinary(file, rows);
+      for ( const auto& vertex : state.vertices )
+      {
+         assert( vertex.size() == d );
+         for ( const auto& entry : vertex )
+         {
+            writeBinary(file, entry);
+         }
+      }
+      for ( std::size_t j = 0; j < rows; ++j )
+      {
+         for ( std::size_t k = 0; k < d; ++k )
+         {
+            writeBinary(file, state.matrix[j][k]);
+         }
+      }
+      // bits are packed into words independently of the bitset type.
+      const auto digits = static_cast<std::size_t>(std::numeric_limits<std::uint64_t>::digits);
+      for ( const auto& bitset : state.R )
+      {
+         for ( std::size_t offset = 0; offset < n; offset += digits )
+         {
+            std::uint64_t word = 0;
+            for ( std::size_t i = offset; i < std::min<std::size_t>(n, offset + digits); ++i )
+            {
+               if ( bitset.test(i) )
+               {
+                  word |= std::uint64_t(1) << (i - offset);
+               }
+            }
+            writeBinary(file, word);
+         }
+      }
+      file.flush();
+      if ( !file )
+      {
+         throw std::runtime_error("Cannot write checkpoint file \"" + temporary + "\".");
+      }
+   }
+   implementation::replaceFile(temporary, filename);
+}
+
+template <typename Integer, typename Bitset>
+panda::FourierMotzkinState<Integer, Bitset> panda::readCheckpoint(const std::string& filename, const std::uint64_t fingerprint)
+{
+   std::ifstream file(filename, std::ios::binary);
+   if ( !file )
+   {
+      throw std::invalid_argument("Cannot open checkpoint file \"" + filename + "\".");
+   }
+   char magic[sizeof(implementation::checkpoint_magic) - 1];
+   file.read(magic, sizeof(magic));
+   if ( !file || std::memcmp(magic, implementation::checkpoint_magic, sizeof(magic)) != 0 )
+   {
+      throw std::invalid_argument("File \"" + filename + "\" is not a checkpoint.");
+   }
+   FourierMotzkinState<Integer, Bitset> state{0, 0, 0.0, Vertices<Integer>(), DenseMatrix<Integer>(), std::vector<Bitset>()};
+   std::uint64_t step = 0;
+   std::uint64_t n = 0;
+   std::uint64_t d = 0;
+   std::uint64_t rows = 0;
+   readBinary(file, state.fingerprint);
+   readBinary(file, step);
+   readBinary(file, state.survival);
+   readBinary(file, n);
+   readBinary(file, d);
+   readBinary(file, rows);
+   if ( !file || state.fingerprint != fingerprint )
+   {
+      throw std::invalid_argument("Checkpoint \"" + filename + "\" belongs to a different input or different settings.");
+   }
+   state.step = static_cast<std::size_t>(step);
+   state.vertices.assign(n, Vertex<Integer>(d));
+   for ( auto& vertex : state.vertices )
+   {
+      for ( auto& entry : vertex )
+      {
+         readBinary(file, entry);
+      }
+   }
+   state.matrix = DenseMatrix<Integer>(rows, d);
+   for ( std::size_t j = 0; j < rows; ++j )
+   {
+      for ( std::size_t k = 0; k < d; ++k )
+      {
+         readBinary(file, state.matrix[j][k]);
+      }
+   }
+   const auto digits = static_cast<std::size_t>(std::numeric_limits<std::uint64_t>::digits);
+   state.R.assign(rows, Bitset(n));
+   for ( auto& bitset : state.R )
+   {
+      for ( std::size_t offset = 0; offset < n; offset += digits )
+      {
+         std::uint64_t word = 0;
+         readBinary(file, word);
+         for ( std::size_t i = offset; i < std::min<std::size_t>(n, offset + digits); ++i )
+         {
+            if ( (word >> (i - offset)) & 1u )
+            {
+               bitset.set(i);
+            }
+         }
+      }
+   }
+   if ( !file )
+   {
+      throw std::invalid_argument("Checkpoint \"" + filename + "\" is truncated.");
+   }
+   return state;
+}
+
+template <typename Integer, typename Bitset>
+panda::CheckpointWriter<Integer, Bitset>::CheckpointWriter(std::string filename_)
+:
+   filename(std::move(filename_)),
+   busy(std::make_shared<std::atomic<bool>>(false)),
+   thread()
+{
+}
+
+template <typename Integer, typename Bitset>
+bool panda::CheckpointWriter<Integer, Bitset>::idle() const noexcept
+{
+   return !busy->load();
+}
+
+template <typename Integer, typename Bitset>
+void panda::CheckpointWriter<Integer, Bitset>::write(FourierMotzkinState<Integer, Bitset> state)
+{
+   assert( idle() );
+   busy->store(true);
+   // joins the thread of the previous checkpoint, which has already finished.
+   thread.reset();
+   const auto& name = filename;
+   const auto flag = busy;
+   thread.reset(new JoiningThread([name, flag](const FourierMotzkinState<Integer, Bitset>& snapshot)
+   {
+      try
+      {
+         writeCheckpoint(name, snapshot);
+      }
+      catch ( const std::exception& e )
+      {
+         std::cerr << e.what() << '\n';
+      }
+      flag->store(false);
+   }, std::move(state)));
+}
+
@@ -0,0 +1,34 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "dense_matrix.h"
+#include "fourier_motzkin_settings.h"
+#include "matrix.h"
+
+namespace panda
+{
+   /// Called after each step of phase 2 with the index of the inserted vertex and the number of rows of the system.
+   /// Phase 2 stops, leaving an incomplete system, if it returns false.
+   using FourierMotzkinStepObserver = std::function<bool(std::size_t, std::size_t)>;
+
+   namespace algorithm
+   {
+      /// The actual FME, named phase Two in Christof, with the given bitset type for the incidences.
+      /// The vertices before the given index are already inserted into the system. Adaptive insertion orders
+      /// rearrange the vertices not yet inserted. Instantiated for BitsetSparse and the fixed size bitsets
+      /// phase 2 is dispatched to, each in one of the translation units fourier_motzkin_phase_two_*.cpp.
+      template <typename Bitset, typename Integer>
+      void fourierMotzkinPhaseTwo(DenseMatrix<Integer>&, Vertices<Integer>&, const FourierMotzkinSettings&, const std::size_t, const FourierMotzkinStepObserver&);
+      /// Abortable phase Two: stops at the first step after which some rows are valid for all vertices, and keeps those.
+      template <typename Integer>
+      void fourierMotzkinPhaseTwoHeuristic(DenseMatrix<Integer>&, const Vertices<Integer>&);
+   }
+}
@@ -0,0 +1,1164 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Definitions of phase 2 of the Fourier-Motzkin elimination. Phase 2 is compiled for each bitset type and integer type,
+/// these are distributed over the translation units fourier_motzkin_phase_two_*.cpp, which include this file.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <forward_list>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "algorithm_integer_operations.h"
+#include "algorithm_matrix_operations.h"
+#include "algorithm_row_operations.h"
+#include "bitset_fixed_size.h"
+#include "bitset_sparse.h"
+#include "bitset_variable_size.h"
+#include "delayed_action.h"
+#include "dense_matrix.h"
+#include "fourier_motzkin_checkpoint.h"
+#include "minimal_subset_index.h"
+#include "parallel_for.h"
+#include "range.h"
+#include "row_file.h"
+#include "transposed_incidence_matrix.h"
+
+using namespace panda;
+
+namespace
+{
+   using Index = std::size_t;
+   using Indices = std::vector<Index>;
+   /// Candidates for new rows: the indices of the combined rows and the resulting bitset.
+   template <typename Bitset>
+   using PNRs = std::forward_list<std::tuple<Index, Index, Bitset>>;
+   /// The actual FME, named phase Two in Christof. Adaptive insertion orders rearrange the vertices not yet inserted.
+   template <typename Bitset, typename Integer>
+   void phaseTwo(DenseMatrix<Integer>&, Vertices<Integer>&, const FourierMotzkinSettings&, const std::size_t, const FourierMotzkinStepObserver&);
+   /// Abortable phase Two.
+   template <typename Bitset, typename Integer>
+   void phaseTwoHeuristic(DenseMatrix<Integer>&, const Vertices<Integer>&);
+   /// Identifies indices of positive, zero and negative entries.
+   template <typename Integer>
+   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>&);
+   /// Identifies indices of positive, zero and negative entries.
+   template <typename Integer, typename Bitset>
+   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>&, const std::vector<Bitset>&, const std::size_t);
+   /// Calculates the product of matrix and vertex, distributed over the given number of threads.
+   template <typename Integer>
+   Row<Integer> slacks(const DenseMatrix<Integer>&, const Vertex<Integer>&, const std::size_t, const ForEach&);
+   /// Calculates the product of the rows in a file and a vertex block by block.
+   template <typename Integer>
+   Row<Integer> slacks(RowFile<Integer>&, const Vertex<Integer>&, const std::size_t, const ForEach&);
+   /// Scalar product of a row of a dense matrix and a vertex.
+   template <typename Integer>
+   Integer product(const Integer*, const Vertex<Integer>&);
+   /// Index of the first vertex from the given index on that lies strictly outside of the row, the number of vertices if there is none.
+   template <typename Integer>
+   Index firstViolation(const Integer*, const Vertices<Integer>&, const Index);
+   /// Stores a * x - b * y divided by its gcd in the result. All three have the given size.
+   template <typename Integer>
+   void combine(Integer*, const Integer&, const Integer*, const Integer&, const Integer*, const std::size_t);
+   /// Updates the system of matrix and indices in place: positive rows are replaced by the new rows.
+   /// The new rows are built in the last argument, which keeps its memory for the next step.
+   template <typename Bitset, typename Integer>
+   void updateSystem(
+      DenseMatrix<Integer>&,
+      std::vector<Bitset>&,
+      const Index,
+      const Row<Integer>&,
+      const PNRs<Bitset>&,
+      DenseMatrix<Integer>&,
+      const std::size_t,
+      const ForEach&);
+   /// Updates the system in a file, the new system is written to a new file.
+   /// Pairs are combined tile by tile, a tile being the pairs of a block of negative and a block of positive rows.
+   template <typename Bitset, typename Integer>
+   void updateSystem(
+      RowFile<Integer>&,
+      std::vector<Bitset>&,
+      const Index,
+      const Row<Integer>&,
+      const PNRs<Bitset>&,
+      const std::size_t,
+      const ForEach&);
+   /// Minimality filter of candidates based on a list with linear scans.
+   template <typename Bitset>
+   class PnrList;
+   /// Minimality filter of candidates based on a MinimalSubsetIndex.
+   template <typename Bitset>
+   class PnrIndex;
+   /// Collects the minimal candidates of all pairs of negative and positive rows that are adjacent.
+   template <typename Bitset, typename Integer>
+   PNRs<Bitset> adjacentPairs(const std::vector<Bitset>&, const std::tuple<Indices, Indices, Indices>&, const Vertices<Integer>&, const Index, const std::size_t, const FourierMotzkinSettings&);
+   /// Collects the minimal candidates with one of the adjacency tests that only need the bitsets.
+   /// They do not depend on the integer type, so they are compiled once per bitset type.
+   template <typename Bitset>
+   PNRs<Bitset> combinatorialPairs(const std::vector<Bitset>&, const std::tuple<Indices, Indices, Indices>&, const Index, const std::size_t, const FourierMotzkinSettings&, const AdjacencyTest);
+   /// Resolves the automatic adjacency test for a step from the number of rows on the hyperplane, the number of pairs,
+   /// the dimension and the number of inserted vertices.
+   AdjacencyTest chooseAdjacencyTest(const AdjacencyTest, const std::size_t, const std::size_t, const std::size_t, const Index) noexcept;
+   /// Name of an adjacency test as given on the command line.
+   const char* adjacencyTestName(const AdjacencyTest) noexcept;
+   /// Number of rows in a block of negative or positive rows of the pair loop, whose bitsets hold the given number of inserted vertices.
+   template <typename Bitset>
+   std::size_t pairTileSize(const Index) noexcept;
+   /// Collects the minimal candidates of all pairs of negative and positive rows that pass the adjacency test.
+   template <typename Bitset, typename AdjacencyCheck>
+   PNRs<Bitset> candidates(const std::vector<Bitset>&, const std::tuple<Indices, Indices, Indices>&, const Index, const std::size_t, const FourierMotzkinSettings&, const AdjacencyCheck&);
+   /// Collects the minimal candidates as above using the given minimality filter.
+   template <typename Filter, typename Bitset, typename AdjacencyCheck>
+   PNRs<Bitset> collect(const std::vector<Bitset>&, const std::tuple<Indices, Indices, Indices>&, const Index, const std::size_t, const std::size_t, const ForEach&, const AdjacencyCheck&);
+   /// Merges the candidate lists of all chunks of the pair loop into the list a sequential run produces.
+   template <typename Bitset>
+   PNRs<Bitset> mergePnrs(std::vector<PNRs<Bitset>>&, const std::size_t, const std::size_t, const ForEach&);
+   /// Checks minimality of the new system.
+   template <typename Bitset>
+   bool isMinimal(const Bitset&, const PNRs<Bitset>&, const std::size_t);
+   /// Initialization of bitsets in phase 2 from the given number of inserted vertices.
+   template <typename Bitset, typename Integer>
+   std::vector<Bitset> initializeR(const DenseMatrix<Integer>&, const Vertices<Integer>&, const std::size_t);
+   /// Number of negative, zero and positive rows of a projection step.
+   using SignCounts = std::tuple<std::size_t, std::size_t, std::size_t>;
+   /// Chooses the next vertex among those from the given index on according to an adaptive insertion order.
+   /// The rows of the first argument are a sample of a system with the given number of rows.
+   /// Returns its index and the predicted number of rows after its insertion.
+   template <typename Integer>
+   std::pair<Index, double> chooseVertex(const DenseMatrix<Integer>&, const std::size_t, const Vertices<Integer>&, const Index, const FourierMotzkinSettings&, const double);
+   /// Evenly spaced rows of a file.
+   template <typename Integer>
+   DenseMatrix<Integer> sampleRows(RowFile<Integer>&, const std::size_t);
+   /// Checks if a system of the given number of rows and columns exceeds the memory limit.
+   template <typename Integer>
+   bool exceedsMemoryLimit(const std::size_t, const std::size_t, const FourierMotzkinSettings&) noexcept;
+   /// Moves the rows of a matrix to a file.
+   template <typename Integer>
+   std::unique_ptr<RowFile<Integer>> spill(DenseMatrix<Integer>&, const FourierMotzkinSettings&);
+   /// Reads all rows of a file.
+   template <typename Integer>
+   DenseMatrix<Integer> load(RowFile<Integer>&);
+   /// Elimination of one ray. The system is either the matrix or, if it exceeds the memory limit, the file.
+   /// The system is moved between both as its size crosses the memory limit.
+   template <typename Bitset, typename Integer>
+   SignCounts projection(DenseMatrix<Integer>&, std::unique_ptr<RowFile<Integer>>&, std::vector<Bitset>&, const Vertices<Integer>&, const Index, const FourierMotzkinSettings&, DenseMatrix<Integer>&);
+}
+
+template <typename Bitset, typename Integer>
+void panda::algorithm::fourierMotzkinPhaseTwo(DenseMatrix<Integer>& matrix, Vertices<Integer>& vertices, const FourierMotzkinSettings& settings, const std::size_t inserted, const FourierMotzkinStepObserver& observer)
+{
+   phaseTwo<Bitset>(matrix, vertices, settings, inserted, observer);
+}
+
+template <typename Integer>
+void panda::algorithm::fourierMotzkinPhaseTwoHeuristic(DenseMatrix<Integer>& matrix, const Vertices<Integer>& vertices)
+{
+   phaseTwoHeuristic<BitsetVariableSize>(matrix, vertices);
+}
+
+namespace
+{
+   template <typename Integer>
+   Index firstViolation(const Integer* row, const Vertices<Integer>& vertices, const Index start)
+   {
+      for ( auto k = start; k < vertices.size(); ++k )
+      {
+         if ( product(row, vertices[k]) > 0 )
+         {
+            return k;
+         }
+      }
+      return vertices.size();
+   }
+
+   template <typename Bitset>
+   std::size_t pairTileSize(const Index index) noexcept
+   {
+      // the bitsets hold a bit per inserted vertex, a tile of them takes about half of a 32 KiB L1 cache.
+      const auto bytes = (1 + index / std::numeric_limits<typename Bitset::DataType>::digits) * sizeof(typename Bitset::DataType);
+      return std::max<std::size_t>(16, (std::size_t(1) << 14) / bytes);
+   }
+
+   template <typename Bitset>
+   bool countCheck(const Bitset& Rn, const Bitset& Rp, const std::size_t max_count, const std::size_t max)
+   {
+      return Bitset::unionCount(Rn, Rp, max) <= max_count;
+   }
+
+   template <typename Bitset>
+   bool containmentCheck(const Bitset& Rn, const Bitset& Rp, const std::size_t max, const std::vector<Bitset>& R, const Indices& indices_zero)
+   {
+      return std::all_of(indices_zero.cbegin(), indices_zero.cend(), [&](const std::size_t index_z)
+      {
+         return !Bitset::unionContains(Rn, Rp, R[index_z], max);
+      });
+   }
+
+   template <typename Bitset, typename Integer>
+   bool rankCheck(const Bitset& Rn, const Bitset& Rp, const Vertices<Integer>& vertices, const std::size_t max)
+   {
+      // two rows are adjacent iff the vertices on both span a subspace of codimension 2.
+      const auto d = vertices.front().size();
+      Matrix<Integer> common;
+      for ( const auto j : unsetBits(Rn.merge(Rp, max), max) )
+      {
+         common.push_back(vertices[j]);
+      }
+      if ( common.empty() )
+      {
+         return d == 2;
+      }
+      return common.size() >= d - 2 && algorithm::dimension(std::move(common)) == d - 2;
+   }
+
+   template <typename Bitset>
+   void pnrIteration(PNRs<Bitset>& pnrs,
+                     const std::size_t index_n,
+                     const std::size_t index_p,
+                     const Bitset& u,
+                     const std::size_t max)
+   {
+      using Iterator = typename PNRs<Bitset>::iterator;
+      std::vector<Iterator> removal;
+      for ( auto it = pnrs.begin(), bit = pnrs.before_begin(); it != pnrs.end(); ++it, ++bit )
+      {
+         const auto& Rpnr = std::get<2>(*it);
+         if ( u.contains(Rpnr, max) )
+         {
+            return;
+         }
+         if ( Rpnr.contains(u, max) )
+         {
+            removal.push_back(bit);
+         }
+      }
+      for ( const auto& entry : makeReverseRange(removal) )
+      {
+         pnrs.erase_after(entry);
+      }
+      pnrs.push_front(std::make_tuple(index_n, index_p, u));
+   }
+
+   template <typename Bitset>
+   class PnrList
+   {
+      public:
+         explicit PnrList(const std::size_t max_)
+         :
+            max(max_),
+            pnrs()
+         {
+         }
+         void insert(const Index index_n, const Index index_p, const Bitset& u)
+         {
+            pnrIteration(pnrs, index_n, index_p, u, max);
+         }
+         /// Merges the filters of consecutive chunks of the pair loop.
+         static PNRs<Bitset> merge(std::vector<PnrList>& filters, const std::size_t max, const std::size_t thread_count, const ForEach& for_each)
+         {
+            std::vector<PNRs<Bitset>> chunk_pnrs;
+            chunk_pnrs.reserve(filters.size());
+            for ( auto& filter : filters )
+            {
+               chunk_pnrs.push_back(std::move(filter.pnrs));
+            }
+            return mergePnrs(chunk_pnrs, max, thread_count, for_each);
+         }
+      private:
+         std::size_t max;
+         PNRs<Bitset> pnrs;
+   };
+
+   template <typename Bitset>
+   class PnrIndex
+   {
+      public:
+         explicit PnrIndex(const std::size_t max)
+         :
+            index(max)
+         {
+         }
+         void insert(const Index index_n, const Index index_p, const Bitset& u)
+         {
+            index.insert(u, std::make_pair(index_n, index_p));
+         }
+         /// Merges the filters of consecutive chunks of the pair loop.
+         /// Reinserting the survivors of all chunks in their original order yields the sequential result.
+         static PNRs<Bitset> merge(std::vector<PnrIndex>& filters, const std::size_t max, const std::size_t, const ForEach&)
+         {
+            PnrIndex merged(max);
+            for ( auto& filter : filters )
+            {
+               for ( const auto& entry : filter.index.release() )
+               {
+                  merged.index.insert(entry.first, entry.second);
+               }
+            }
+            // same order as PnrList: last insertion first
+            PNRs<Bitset> pnrs;
+            for ( auto& entry : merged.index.release() )
+            {
+               pnrs.push_front(std::make_tuple(entry.second.first, entry.second.second, std::move(entry.first)));
+            }
+            return pnrs;
+         }
+      private:
+         MinimalSubsetIndex<Bitset, std::pair<Index, Index>> index;
+   };
+
+   template <typename Bitset, typename Integer>
+   SignCounts projection(DenseMatrix<Integer>& matrix, std::unique_ptr<RowFile<Integer>>& spilled, std::vector<Bitset>& R, const Vertices<Integer>& vertices, const Index index, const FourierMotzkinSettings& settings, DenseMatrix<Integer>& new_rows)
+   {
+      assert( spilled || !matrix.empty() );
+      assert( index < vertices.size() );
+      const auto& vertex = vertices[index];
+      const auto d = vertex.size();
+      assert( (spilled ? spilled->columns() : matrix.columns()) == d );
+      assert( index >= d );
+      const auto thread_count = settings.thread_count;
+      const auto s = spilled ? slacks(*spilled, vertex, thread_count, settings.for_each) : slacks(matrix, vertex, thread_count, settings.for_each);
+      const auto indices = getIndicesNZP(s, R, index);
+      const auto pnrs = adjacentPairs(R, indices, vertices, index, index + 2 - d, settings);
+      // the size of the new system is known before any new row is built.
+      const auto new_size = s.size() - std::get<2>(indices).size() + static_cast<std::size_t>(std::distance(pnrs.cbegin(), pnrs.cend()));
+      if ( !spilled && exceedsMemoryLimit<Integer>(new_size, d, settings) )
+      {
+         std::cerr << "Fourier-Motzkin Elimination step " << index + 1 << ": " << new_size << " rows exceed the memory limit, moving the system to temporary files.\n";
+         spilled = spill(matrix, settings);
+      }
+      if ( spilled )
+      {
+         updateSystem(*spilled, R, index, s, pnrs, thread_count, settings.for_each);
+         // the system returns to memory only well below the limit, so that it does not move back and forth.
+         if ( !exceedsMemoryLimit<Integer>(2 * new_size, d, settings) )
+         {
+            std::cerr << "Fourier-Motzkin Elimination step " << index + 1 << ": " << new_size << " rows fit into memory again.\n";
+            matrix = load(*spilled);
+            spilled.reset();
+         }
+      }
+      else
+      {
+         updateSystem(matrix, R, index, s, pnrs, new_rows, thread_count, settings.for_each);
+      }
+      return SignCounts(std::get<0>(indices).size(), std::get<1>(indices).size(), std::get<2>(indices).size());
+   }
+
+   template <typename Bitset, typename Integer>
+   PNRs<Bitset> adjacentPairs(const std::vector<Bitset>& R, const std::tuple<Indices, Indices, Indices>& indices, const Vertices<Integer>& vertices, const Index index, const std::size_t max_count, const FourierMotzkinSettings& settings)
+   {
+      const auto& indices_zero = std::get<1>(indices);
+      const auto d = vertices[index].size();
+      const auto pairs = std::get<0>(indices).size() * std::get<2>(indices).size();
+      const auto test = chooseAdjacencyTest(settings.adjacency_test, indices_zero.size(), pairs, d, index);
+      if ( settings.adjacency_test == AdjacencyTest::Automatic )
+      {
+         std::cerr << "Fourier-Motzkin Elimination step " << index + 1 << ": " << adjacencyTestName(test) << " adjacency test, " << indices_zero.size() << " rows on the hyperplane, " << pairs << " pairs\n";
+      }
+      if ( test == AdjacencyTest::Algebraic )
+      {
+         return candidates(R, indices, index, max_count, settings, [&](const Bitset& Rn, const Bitset& Rp, std::vector<TransposedIncidenceMatrix::DataType>&)
+         {
+            return rankCheck(Rn, Rp, vertices, index);
+         });
+      }
+      return combinatorialPairs(R, indices, index, max_count, settings, test);
+   }
+
+   template <typename Bitset>
+   PNRs<Bitset> combinatorialPairs(const std::vector<Bitset>& R, const std::tuple<Indices, Indices, Indices>& indices, const Index index, const std::size_t max_count, const FourierMotzkinSettings& settings, const AdjacencyTest test)
+   {
+      const auto& indices_zero = std::get<1>(indices);
+      if ( test == AdjacencyTest::Transposed )
+      {
+         const TransposedIncidenceMatrix incidences(R, indices_zero, index);
+         return candidates(R, indices, index, max_count, settings, [&](const Bitset& Rn, const Bitset& Rp, std::vector<TransposedIncidenceMatrix::DataType>& buffer)
+         {
+            return !incidences.unionContainsAny(Rn, Rp, buffer);
+         });
+      }
+      return candidates(R, indices, index, max_count, settings, [&](const Bitset& Rn, const Bitset& Rp, std::vector<TransposedIncidenceMatrix::DataType>&)
+      {
+         return containmentCheck(Rn, Rp, index, R, indices_zero);
+      });
+   }
+
+   const char* adjacencyTestName(const AdjacencyTest test) noexcept
+   {
+      switch ( test )
+      {
+         case AdjacencyTest::Scan:
+            return "scan";
+         case AdjacencyTest::Transposed:
+            return "transposed";
+         case AdjacencyTest::Algebraic:
+            return "algebraic";
+         case AdjacencyTest::Automatic:
+            break;
+      }
+      return "auto";
+   }
+
+   AdjacencyTest chooseAdjacencyTest(const AdjacencyTest test, const std::size_t zero, const std::size_t pairs, const std::size_t d, const Index index) noexcept
+   {
+      if ( test != AdjacencyTest::Automatic )
+      {
+         return test;
+      }
+      // estimated word operations of the step:
+      // the scan compares every pair with every row on the hyperplane,
+      // the transposed index is built once and intersects at least d - 2 columns per pair,
+      // the algebraic test collects at least d - 2 common vertices per pair and eliminates them.
+      const auto words = 1 + (index - 1) / 64;
+      const auto zero_words = 1 + zero / 64;
+      const auto scan = pairs * zero * words;
+      const auto transposed = zero * words + pairs * (d - 2) * zero_words;
+      const auto algebraic = pairs * (words + (d - 2) * d * d);
+      if ( algebraic < scan && algebraic < transposed )
+      {
+         return AdjacencyTest::Algebraic;
+      }
+      return ( transposed < scan ) ? AdjacencyTest::Transposed : AdjacencyTest::Scan;
+   }
+
+   template <typename Integer>
+   bool exceedsMemoryLimit(const std::size_t rows, const std::size_t columns, const FourierMotzkinSettings& settings) noexcept
+   {
+      // only the entries of the rows are counted, the incidences take a bit per vertex.
+      return settings.memory_limit > 0 && rows * columns * sizeof(Integer) > settings.memory_limit;
+   }
+
+   template <typename Integer>
+   std::unique_ptr<RowFile<Integer>> spill(DenseMatrix<Integer>& matrix, const FourierMotzkinSettings& settings)
+   {
+      const auto d = matrix.columns();
+      // a tile of the pair loop holds three blocks: negative rows, positive rows and their combinations.
+      const auto block_size = std::max<std::size_t>(1, settings.memory_limit / (8 * d * sizeof(Integer)));
+      std::unique_ptr<RowFile<Integer>> file(new RowFile<Integer>(d, block_size));
+      for ( std::size_t j = 0; j < matrix.rows(); ++j )
+      {
+         file->append(matrix[j]);
+      }
+      matrix = DenseMatrix<Integer>(0, d);
+      return file;
+   }
+
+   template <typename Integer>
+   DenseMatrix<Integer> load(RowFile<Integer>& file)
+   {
+      DenseMatrix<Integer> matrix(0, file.columns());
+      matrix.reserveRows(file.rows());
+      for ( std::size_t b = 0; b < file.blocks(); ++b )
+      {
+         const auto block = file.block(b);
+         const auto first = matrix.rows();
+         matrix.resizeRows(first + block.rows());
+         for ( std::size_t r = 0; r < block.rows(); ++r )
+         {
+            std::copy(block[r], block[r] + block.columns(), matrix[first + r]);
+         }
+      }
+      return matrix;
+   }
+
+   template <typename Integer>
+   DenseMatrix<Integer> sampleRows(RowFile<Integer>& file, const std::size_t sample_size)
+   {
+      const auto stride = std::max<std::size_t>(1, file.rows() / sample_size);
+      DenseMatrix<Integer> sample(0, file.columns());
+      for ( std::size_t b = 0, j = 0; b < file.blocks(); ++b )
+      {
+         const auto block = file.block(b);
+         for ( std::size_t r = 0; r < block.rows(); ++r, ++j )
+         {
+            if ( j % stride == 0 )
+            {
+               sample.resizeRows(sample.rows() + 1);
+               std::copy(block[r], block[r] + block.columns(), sample[sample.rows() - 1]);
+            }
+         }
+      }
+      return sample;
+   }
+
+   bool isAdaptive(const InputOrder order) noexcept
+   {
+      return order == InputOrder::MinCutoff || order == InputOrder::MaxIntersection || order == InputOrder::PredictedMin;
+   }
+
+   template <typename Integer>
+   std::pair<Index, double> chooseVertex(const DenseMatrix<Integer>& matrix, const std::size_t row_count, const Vertices<Integer>& vertices, const Index first, const FourierMotzkinSettings& settings, const double survival)
+   {
+      assert( first < vertices.size() );
+      // signs are counted on evenly spaced sample rows and scaled to the whole system.
+      const std::size_t sample_size = 1024;
+      const auto stride = std::max<std::size_t>(1, matrix.rows() / sample_size);
+      const auto candidate_count = vertices.size() - first;
+      std::vector<double> scores(candidate_count);
+      std::vector<double> predictions(candidate_count);
+      parallelFor(candidate_count, settings.thread_count, settings.for_each, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         for ( auto k = begin; k < end; ++k )
+         {
+            std::size_t n = 0;
+            std::size_t z = 0;
+            std::size_t p = 0;
+            for ( std::size_t j = 0; j < matrix.rows(); j += stride )
+            {
+               const auto slack = product(matrix[j], vertices[first + k]);
+               if ( slack < 0 )
+               {
+                  ++n;
+               }
+               else if ( slack == 0 )
+               {
+                  ++z;
+               }
+               else
+               {
+                  ++p;
+               }
+            }
+            const auto scale = static_cast<double>(row_count) / static_cast<double>(std::max<std::size_t>(1, n + z + p));
+            const auto negative = scale * static_cast<double>(n);
+            const auto zero = scale * static_cast<double>(z);
+            const auto positive = scale * static_cast<double>(p);
+            predictions[k] = zero + negative + survival * negative * positive;
+            switch ( settings.insertion_order )
+            {
+               case InputOrder::MinCutoff:
+                  scores[k] = positive;
+                  break;
+               case InputOrder::MaxIntersection:
+                  scores[k] = -zero;
+                  break;
+               default:
+                  scores[k] = predictions[k];
+            }
+         }
+      });
+      // ties are broken by the original order.
+      const auto best = static_cast<std::size_t>(std::min_element(scores.cbegin(), scores.cend()) - scores.cbegin());
+      return std::make_pair(first + best, predictions[best]);
+   }
+
+   template <typename Bitset, typename AdjacencyCheck>
+   PNRs<Bitset> candidates(
+      const std::vector<Bitset>& R,
+      const std::tuple<Indices, Indices, Indices>& indices,
+      const Index index,
+      const std::size_t max_count,
+      const FourierMotzkinSettings& settings,
+      const AdjacencyCheck& adjacencyCheck)
+   {
+      if ( settings.pair_filter == PairFilter::List )
+      {
+         return collect<PnrList<Bitset>>(R, indices, index, max_count, settings.thread_count, settings.for_each, adjacencyCheck);
+      }
+      return collect<PnrIndex<Bitset>>(R, indices, index, max_count, settings.thread_count, settings.for_each, adjacencyCheck);
+   }
+
+   template <typename Filter, typename Bitset, typename AdjacencyCheck>
+   PNRs<Bitset> collect(
+      const std::vector<Bitset>& R,
+      const std::tuple<Indices, Indices, Indices>& indices,
+      const Index index,
+      const std::size_t max_count,
+      const std::size_t thread_count,
+      const ForEach& for_each,
+      const AdjacencyCheck& adjacencyCheck)
+   {
+      const auto& indices_negative = std::get<0>(indices);
+      const auto& indices_positive = std::get<2>(indices);
+      // the bitsets of the positive rows are gathered, so that a tile of them stays in the cache
+      // while a block of negative rows is checked against it.
+      std::vector<Bitset> positive;
+      positive.reserve(indices_positive.size());
+      for ( const auto& index_p : indices_positive )
+      {
+         positive.push_back(R[index_p]);
+      }
+      const auto tile = pairTileSize<Bitset>(index);
+      // each chunk of negative rows collects its own candidates, which are merged afterwards.
+      std::vector<Filter> filters(chunkCount(indices_negative.size(), thread_count), Filter(index));
+      parallelFor(indices_negative.size(), thread_count, for_each, [&](const std::size_t chunk, const std::size_t begin, const std::size_t end)
+      {
+         auto& filter = filters[chunk];
+         std::vector<TransposedIncidenceMatrix::DataType> buffer;
+         std::vector<Indices> adjacent;
+         for ( auto block = begin; block < end; block += tile )
+         {
+            const auto block_end = std::min(end, block + tile);
+            adjacent.assign(block_end - block, Indices());
+            for ( std::size_t first = 0; first < positive.size(); first += tile )
+            {
+               const auto last = std::min(positive.size(), first + tile);
+               for ( auto k = block; k < block_end; ++k )
+               {
+                  const auto& Rn = R[indices_negative[k]];
+                  for ( auto q = first; q < last; ++q )
+                  {
+                     if ( countCheck(Rn, positive[q], max_count, index) && adjacencyCheck(Rn, positive[q], buffer) )
+                     {
+                        adjacent[k - block].push_back(q);
+                     }
+                  }
+               }
+            }
+            // the filter keeps the first of equal candidates, so they are inserted in the order of the untiled loop.
+            for ( auto k = block; k < block_end; ++k )
+            {
+               const auto index_n = indices_negative[k];
+               for ( const auto q : adjacent[k - block] )
+               {
+                  filter.insert(index_n, indices_positive[q], R[index_n].merge(positive[q], index));
+               }
+            }
+         }
+      });
+      return Filter::merge(filters, index, thread_count, for_each);
+   }
+
+   template <typename Bitset>
+   PNRs<Bitset> mergePnrs(std::vector<PNRs<Bitset>>& chunk_pnrs, const std::size_t max, const std::size_t thread_count, const ForEach& for_each)
+   {
+      if ( chunk_pnrs.size() <= 1 )
+      {
+         return chunk_pnrs.empty() ? PNRs<Bitset>() : std::move(chunk_pnrs.front());
+      }
+      // Each chunk holds the minimal candidates of its own range, the oldest one last.
+      // A candidate survives the merge if no other chunk holds a proper subset of it,
+      // nor an equal set found earlier in the sequential order.
+      std::vector<std::pair<std::size_t, typename PNRs<Bitset>::value_type*>> candidates;
+      for ( std::size_t chunk = 0; chunk < chunk_pnrs.size(); ++chunk )
+      {
+         const auto first = candidates.size();
+         for ( auto& pnr : chunk_pnrs[chunk] )
+         {
+            candidates.emplace_back(chunk, &pnr);
+         }
+         std::reverse(candidates.begin() + static_cast<std::ptrdiff_t>(first), candidates.end());
+      }
+      std::vector<char> survives(candidates.size(), 1);
+      parallelFor(candidates.size(), thread_count, for_each, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         for ( auto k = begin; k < end; ++k )
+         {
+            const auto chunk = candidates[k].first;
+            const auto& u = std::get<2>(*candidates[k].second);
+            for ( const auto& other : candidates )
+            {
+               if ( other.first == chunk )
+               {
+                  continue;
+               }
+               const auto& v = std::get<2>(*other.second);
+               if ( u.contains(v, max) && (other.first < chunk || !v.contains(u, max)) )
+               {
+                  survives[k] = 0;
+                  break;
+               }
+            }
+         }
+      });
+      PNRs<Bitset> pnrs;
+      for ( std::size_t k = 0; k < candidates.size(); ++k )
+      {
+         if ( survives[k] )
+         {
+            pnrs.push_front(std::move(*candidates[k].second));
+         }
+      }
+      return pnrs;
+   }
+
+   template <typename Integer>
+   void detectBadRow(Matrix<Integer>& matrix)
+   {
+      for ( std::size_t j = 0; j < matrix.size(); ++j )
+      {
+         const auto& row = matrix[j];
+         bool possible = true;
+         for ( std::size_t k = 0; k + 1 < row.size() && possible; ++k )
+         {
+            possible = (row[k] == 0);
+         }
+         if ( possible && row.back() == -1 )
+         {
+            matrix.erase(matrix.begin() + static_cast<typename Matrix<Integer>::difference_type>(j));
+         }
+      }
+   }
+
+   template <typename Integer>
+   void detectBadRow(DenseMatrix<Integer>& matrix)
+   {
+      const auto d = matrix.columns();
+      for ( std::size_t j = 0; j < matrix.rows(); ++j )
+      {
+         const auto row = matrix[j];
+         bool possible = true;
+         for ( std::size_t k = 0; k + 1 < d && possible; ++k )
+         {
+            possible = (row[k] == 0);
+         }
+         if ( possible && row[d - 1] == -1 )
+         {
+            matrix.eraseRows(j, j + 1);
+         }
+      }
+   }
+
+   template <typename Bitset, typename Integer>
+   void phaseTwo(DenseMatrix<Integer>& matrix, Vertices<Integer>& vertices, const FourierMotzkinSettings& settings, const std::size_t inserted, const FourierMotzkinStepObserver& observer)
+   {
+      assert( !matrix.empty() );
+      const auto d = matrix.columns();
+      auto R = initializeR<Bitset>(matrix, vertices, inserted);
+      DenseMatrix<Integer> new_rows(0, d);
+      const auto adaptive = isAdaptive(settings.insertion_order);
+      // fraction of adjacent pairs among all pairs of negative and positive rows, learned from the previous steps.
+      double survival = 1.0;
+      assert( d <= inserted && inserted <= vertices.size() );
+      auto first_step = inserted;
+      const auto checkpointing = !settings.checkpoint_file.empty() || !settings.resume_file.empty();
+      const auto fingerprint = checkpointing ? fourierMotzkinFingerprint(matrix, vertices, static_cast<int>(settings.insertion_order)) : 0u;
+      if ( !settings.resume_file.empty() )
+      {
+         auto state = readCheckpoint<Integer, Bitset>(settings.resume_file, fingerprint);
+         first_step = state.step;
+         survival = state.survival;
+         vertices = std::move(state.vertices);
+         matrix = std::move(state.matrix);
+         R = std::move(state.R);
+         std::cerr << "Resuming Fourier-Motzkin Elimination at step " << first_step + 1 << " / " << vertices.size() << ": " << matrix.rows() << '\n';
+      }
+      CheckpointWriter<Integer, Bitset> checkpoints(settings.checkpoint_file);
+      auto last_checkpoint = std::chrono::steady_clock::now();
+      // the system while it exceeds the memory limit, the matrix is empty then.
+      std::unique_ptr<RowFile<Integer>> spilled;
+      const auto rows = [&]()
+      {
+         return spilled ? spilled->rows() : matrix.rows();
+      };
+      for ( std::size_t i = first_step; i < vertices.size(); ++i )
+      {
+         const auto now = std::chrono::steady_clock::now();
+         // no checkpoints are taken while the system is in files.
+         if ( !settings.checkpoint_file.empty() && !spilled && now - last_checkpoint >= settings.checkpoint_interval && checkpoints.idle() )
+         {
+            // the snapshot is copied here, serialization and disk access happen in the background.
+            checkpoints.write(FourierMotzkinState<Integer, Bitset>{fingerprint, i, survival, vertices, matrix, R});
+            last_checkpoint = now;
+         }
+         double prediction = 0.0;
+         if ( adaptive )
+         {
+            // bits of vertices not yet inserted are unset in R, so their order may change.
+            std::size_t next;
+            if ( spilled )
+            {
+               std::tie(next, prediction) = chooseVertex(sampleRows(*spilled, 1024), spilled->rows(), vertices, i, settings, survival);
+            }
+            else
+            {
+               std::tie(next, prediction) = chooseVertex(matrix, matrix.rows(), vertices, i, settings, survival);
+            }
+            std::swap(vertices[i], vertices[next]);
+         }
+         auto action = makeDelayedAction([&]()
+         {
+            std::cerr << "Fourier-Motzkin Elimination step " << i + 1 << " / " << vertices.size() << ": " << rows() << '\n';
+         }, std::chrono::seconds(2));
+         const auto counts = projection(matrix, spilled, R, vertices, i, settings, new_rows);
+         if ( adaptive )
+         {
+            std::cerr << "Fourier-Motzkin Elimination step " << i + 1 << " / " << vertices.size() << ": predicted " << static_cast<std::size_t>(prediction + 0.5) << ", actual " << rows() << '\n';
+            const auto pairs = std::get<0>(counts) * std::get<2>(counts);
+            if ( pairs > 0 )
+            {
+               const auto combined = rows() - std::get<0>(counts) - std::get<1>(counts);
+               survival = (survival + static_cast<double>(combined) / static_cast<double>(pairs)) / 2.0;
+            }
+         }
+         if ( observer && !observer(i, rows()) )
+         {
+            return;
+         }
+      }
+      if ( spilled )
+      {
+         matrix = load(*spilled);
+      }
+      detectBadRow(matrix);
+   }
+
+   template <typename Bitset, typename Integer>
+   void phaseTwoHeuristic(DenseMatrix<Integer>& matrix, const Vertices<Integer>& vertices)
+   {
+      const auto d = matrix.rows();
+      auto R = initializeR<Bitset>(matrix, vertices, d);
+      DenseMatrix<Integer> new_rows(0, matrix.columns());
+      std::unique_ptr<RowFile<Integer>> spilled;
+      assert( d <= vertices.size() );
+      // a row stays in the system until the first vertex it does not contain is inserted, so the index of this
+      // vertex is computed once per row, when it is created. Rows without such a vertex are valid for all remaining
+      // vertices and counted, so the test for facets takes constant time per step.
+      // The search stops at the first violation: it costs O(d) per vertex it passes, O(d * n) only for valid rows.
+      // A set of all violations per row (to bound the search of a new row by the violations of its parents)
+      // is not kept, as it takes a full search per row.
+      std::vector<Index> first_violation(matrix.rows());
+      std::size_t valid = 0;
+      for ( std::size_t j = 0; j < matrix.rows(); ++j )
+      {
+         first_violation[j] = firstViolation(matrix[j], vertices, d);
+         valid += ( first_violation[j] == vertices.size() ) ? 1 : 0;
+      }
+      for ( std::size_t i = d; i < vertices.size(); ++i )
+      {
+         if ( valid > 0 )
+         {
+            Facets<Integer> facets;
+            for ( std::size_t j = 0; j < matrix.rows(); ++j )
+            {
+               if ( first_violation[j] == vertices.size() )
+               {
+                  facets.push_back(matrix.row(j));
+               }
+            }
+            detectBadRow(facets);
+            if ( !facets.empty() )
+            {
+               matrix = DenseMatrix<Integer>(facets);
+               break;
+            }
+         }
+         projection(matrix, spilled, R, vertices, i, FourierMotzkinSettings(), new_rows);
+         assert( !spilled );
+         // the rows violated by vertex i are exactly the positive ones, the others keep their order in front of the new rows.
+         first_violation.erase(std::remove(first_violation.begin(), first_violation.end(), i), first_violation.end());
+         const auto kept = first_violation.size();
+         first_violation.resize(matrix.rows());
+         for ( auto j = kept; j < matrix.rows(); ++j )
+         {
+            first_violation[j] = firstViolation(matrix[j], vertices, i + 1);
+            valid += ( first_violation[j] == vertices.size() ) ? 1 : 0;
+         }
+      }
+   }
+
+   template <typename Integer>
+   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>& s)
+   {
+      std::tuple<Indices, Indices, Indices> indices;
+      auto& indices_negative = std::get<0>(indices);
+      auto& indices_zero = std::get<1>(indices);
+      auto& indices_positive = std::get<2>(indices);
+      for ( std::size_t j = 0; j < s.size(); ++j )
+      {
+         if ( s[j] < 0 )
+         {
+            indices_negative.push_back(j);
+         }
+         else if ( s[j] == 0 )
+         {
+            indices_zero.push_back(j);
+         }
+         else // ( s[j] > 0 )
+         {
+            indices_positive.push_back(j);
+         }
+      }
+      return indices;
+   }
+
+   template <typename Integer>
+   Row<Integer> slacks(const DenseMatrix<Integer>& matrix, const Vertex<Integer>& vertex, const std::size_t thread_count, const ForEach& for_each)
+   {
+      Row<Integer> s(matrix.rows(), Integer(0));
+      parallelFor(matrix.rows(), thread_count, for_each, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         for ( auto j = begin; j < end; ++j )
+         {
+            s[j] = product(matrix[j], vertex);
+         }
+      });
+      return s;
+   }
+
+   template <typename Integer>
+   Row<Integer> slacks(RowFile<Integer>& file, const Vertex<Integer>& vertex, const std::size_t thread_count, const ForEach& for_each)
+   {
+      Row<Integer> s(file.rows(), Integer(0));
+      for ( std::size_t b = 0; b < file.blocks(); ++b )
+      {
+         const auto block = file.block(b);
+         const auto first = b * file.blockSize();
+         parallelFor(block.rows(), thread_count, for_each, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+         {
+            for ( auto r = begin; r < end; ++r )
+            {
+               s[first + r] = product(block[r], vertex);
+            }
+         });
+      }
+      return s;
+   }
+
+   template <typename Integer>
+   Integer product(const Integer* row, const Vertex<Integer>& vertex)
+   {
+      return std::inner_product(row, row + vertex.size(), vertex.cbegin(), Integer(0));
+   }
+
+   template <typename Integer, typename Bitset>
+   std::tuple<Indices, Indices, Indices> getIndicesNZP(const Row<Integer>& s, const std::vector<Bitset>& R, const std::size_t max)
+   {
+      auto indices = getIndicesNZP(s);
+      auto& indices_zero = std::get<1>(indices);
+      std::sort(indices_zero.begin(), indices_zero.end(), [&R, &max] (const Index& a, const Index& b) { return R[a].count(max) < R[b].count(max); });
+      return indices;
+   }
+
+   template <typename Integer>
+   void combine(Integer* result, const Integer& a, const Integer* x, const Integer& b, const Integer* y, const std::size_t size)
+   {
+      for ( std::size_t k = 0; k < size; ++k )
+      {
+         result[k] = a * x[k] - b * y[k];
+      }
+      // same normalization as algorithm::gcd(const Row<Integer>&)
+      std::size_t k = 0;
+      for ( ; k < size && result[k] == 0; ++k )
+      {
+      }
+      if ( k == size )
+      {
+         return;
+      }
+      using std::abs;
+      using algorithm::abs;
+      Integer gcd_value = abs(result[k]);
+      for ( ++k; k < size && gcd_value > 1; ++k )
+      {
+         gcd_value = algorithm::gcd(result[k], gcd_value);
+      }
+      if ( gcd_value > 1 )
+      {
+         for ( k = 0; k < size; ++k )
+         {
+            result[k] /= gcd_value;
+         }
+      }
+   }
+
+   template <typename Bitset, typename Integer>
+   void updateSystem(
+      DenseMatrix<Integer>& matrix,
+      std::vector<Bitset>& R,
+      const Index i,
+      const Row<Integer>& s,
+      const PNRs<Bitset>& pnrs,
+      DenseMatrix<Integer>& new_rows,
+      const std::size_t thread_count,
+      const ForEach& for_each)
+   {
+      assert( matrix.rows() == R.size() );
+      assert( matrix.rows() == s.size() );
+      assert( new_rows.columns() == matrix.columns() );
+      const auto d = matrix.columns();
+      // new rows are built before the positive rows they are combined from are overwritten.
+      std::vector<const typename PNRs<Bitset>::value_type*> combinations;
+      for ( const auto& pnr : pnrs )
+      {
+         combinations.push_back(&pnr);
+      }
+      new_rows.resizeRows(combinations.size());
+      parallelFor(combinations.size(), thread_count, for_each, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         for ( auto k = begin; k < end; ++k )
+         {
+            const auto& index_n = std::get<0>(*combinations[k]);
+            const auto& index_p = std::get<1>(*combinations[k]);
+            combine(new_rows[k], s[index_p], matrix[index_n], s[index_n], matrix[index_p], d);
+         }
+      });
+      // zero and negative rows keep their relative order, positive rows are moved behind them.
+      std::size_t kept = 0;
+      for ( std::size_t j = 0; j < matrix.rows(); ++j )
+      {
+         if ( s[j] > 0 )
+         {
+            continue;
+         }
+         if ( s[j] < 0 )
+         {
+            R[j].set(i);
+         }
+         if ( kept != j )
+         {
+            matrix.swapRows(kept, j);
+            std::swap(R[kept], R[j]);
+         }
+         ++kept;
+      }
+      R.erase(R.begin() + static_cast<typename std::vector<Bitset>::difference_type>(kept), R.end());
+      R.reserve(kept + combinations.size());
+      matrix.resizeRows(kept + combinations.size());
+      for ( std::size_t k = 0; k < combinations.size(); ++k )
+      {
+         // swapping leaves the memory of the entries in new_rows for the next step.
+         std::swap_ranges(new_rows[k], new_rows[k] + d, matrix[kept + k]);
+         R.push_back(std::get<2>(*combinations[k]));
+      }
+   }
+
+   template <typename Bitset, typename Integer>
+   void updateSystem(
+      RowFile<Integer>& system,
+      std::vector<Bitset>& R,
+      const Index i,
+      const Row<Integer>& s,
+      const PNRs<Bitset>& pnrs,
+      const std::size_t thread_count,
+      const ForEach& for_each)
+   {
+      assert( system.rows() == R.size() );
+      assert( system.rows() == s.size() );
+      const auto d = system.columns();
+      const auto block_size = system.blockSize();
+      RowFile<Integer> next(d, block_size);
+      // zero and negative rows keep their relative order, as in memory.
+      std::size_t kept = 0;
+      for ( std::size_t b = 0; b < system.blocks(); ++b )
+      {
+         const auto block = system.block(b);
+         for ( std::size_t r = 0; r < block.rows(); ++r )
+         {
+            const auto j = b * block_size + r;
+            if ( s[j] > 0 )
+            {
+               continue;
+            }
+            if ( s[j] < 0 )
+            {
+               R[j].set(i);
+            }
+            next.append(block[r]);
+            if ( kept != j )
+            {
+               std::swap(R[kept], R[j]);
+            }
+            ++kept;
+         }
+      }
+      R.erase(R.begin() + static_cast<typename std::vector<Bitset>::difference_type>(kept), R.end());
+      // pairs are sorted by tile, so that each block of negative rows is read once and each block of positive rows once per tile.
+      std::vector<const typename PNRs<Bitset>::value_type*> combinations;
+      for ( const auto& pnr : pnrs )
+      {
+         combinations.push_back(&pnr);
+      }
+      const auto tile = [block_size](const typename PNRs<Bitset>::value_type* pnr)
+      {
+         return std::make_pair(std::get<0>(*pnr) / block_size, std::get<1>(*pnr) / block_size);
+      };
+      std::stable_sort(combinations.begin(), combinations.end(), [&tile](const typename PNRs<Bitset>::value_type* a, const typename PNRs<Bitset>::value_type* b)
+      {
+         return tile(a) < tile(b);
+      });
+      R.reserve(kept + combinations.size());
+      auto negative_block = std::numeric_limits<std::size_t>::max();
+      auto positive_block = std::numeric_limits<std::size_t>::max();
+      DenseMatrix<Integer> negative_rows;
+      DenseMatrix<Integer> positive_rows;
+      DenseMatrix<Integer> new_rows(0, d);
+      // combinations of a tile are built in portions of at most a block.
+      for ( std::size_t first = 0; first < combinations.size(); )
+      {
+         const auto current = tile(combinations[first]);
+         if ( current.first != negative_block )
+         {
+            negative_block = current.first;
+            negative_rows = system.block(negative_block);
+         }
+         if ( current.second != positive_block )
+         {
+            positive_block = current.second;
+            positive_rows = system.block(positive_block);
+         }
+         auto last = first + 1;
+         while ( last < combinations.size() && last - first < block_size && tile(combinations[last]) == current )
+         {
+            ++last;
+         }
+         new_rows.resizeRows(last - first);
+         parallelFor(last - first, thread_count, for_each, [&](const std::size_t, const std::size_t begin, const std::size_t end)
+         {
+            for ( auto k = begin; k < end; ++k )
+            {
+               const auto& index_n = std::get<0>(*combinations[first + k]);
+               const auto& index_p = std::get<1>(*combinations[first + k]);
+               combine(new_rows[k], s[index_p], negative_rows[index_n - negative_block * block_size], s[index_n], positive_rows[index_p - positive_block * block_size], d);
+            }
+         });
+         for ( auto k = first; k < last; ++k )
+         {
+            next.append(new_rows[k - first]);
+            R.push_back(std::get<2>(*combinations[k]));
+         }
+         first = last;
+      }
+      system = std::move(next);
+   }
+
+   template <typename Bitset>
+   bool isMinimal(const Bitset& bitset, const PNRs<Bitset>& pnrs, const std::size_t max)
+   {
+      for ( const auto& pnr : pnrs )
+      {
+         const auto& Rpnr = std::get<2>(pnr);
+         if ( bitset.contains(Rpnr, max) )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   template <typename Bitset, typename Integer>
+   std::vector<Bitset> initializeR(const DenseMatrix<Integer>& matrix, const Vertices<Integer>& vertices, const std::size_t inserted)
+   {
+      assert( !matrix.empty() );
+      assert( !vertices.empty() );
+      assert( matrix.columns() == vertices.back().size() );
+      assert( inserted <= vertices.size() );
+      std::vector<Bitset> R(matrix.rows(), Bitset(vertices.size()));
+      for ( std::size_t i = 0; i < matrix.rows(); ++i )
+      {
+         const auto row = matrix[i];
+         for ( std::size_t j = 0; j < inserted; ++j )
+         {
+            const auto& vertex = vertices[j];
+            if ( product(row, vertex) < 0 )
+            {
+               R[i].set(j);
+            }
+         }
+      }
+      return R;
+   }
+}
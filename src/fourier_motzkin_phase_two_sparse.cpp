@@ -0,0 +1,16 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Phase 2 with sparse bitsets, used beyond the widths of the fixed size bitsets, and the abortable phase 2.
+
+#include "fourier_motzkin_phase_two.h"
+#include "fourier_motzkin_phase_two.tpp"
+
+#define Bitset panda::BitsetSparse
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#include "fourier_motzkin_phase_two.eti"
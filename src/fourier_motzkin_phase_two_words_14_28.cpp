@@ -0,0 +1,30 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Phase 2 with fixed size bitsets of 14 to 28 words.
+
+#include "fourier_motzkin_phase_two.h"
+#include "fourier_motzkin_phase_two.tpp"
+
+#define Bitset panda::BitsetFixedSize<14>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<16>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<20>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<24>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<28>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
@@ -0,0 +1,30 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Phase 2 with fixed size bitsets of 1 to 5 words.
+
+#include "fourier_motzkin_phase_two.h"
+#include "fourier_motzkin_phase_two.tpp"
+
+#define Bitset panda::BitsetFixedSize<1>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<2>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<3>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<4>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<5>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
@@ -0,0 +1,34 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Phase 2 with fixed size bitsets of 32 to 100 words.
+
+#include "fourier_motzkin_phase_two.h"
+#include "fourier_motzkin_phase_two.tpp"
+
+#define Bitset panda::BitsetFixedSize<32>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<40>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<48>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<64>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<80>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<100>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
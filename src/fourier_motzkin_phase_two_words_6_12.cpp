@@ -0,0 +1,30 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+/// Phase 2 with fixed size bitsets of 6 to 12 words.
+
+#include "fourier_motzkin_phase_two.h"
+#include "fourier_motzkin_phase_two.tpp"
+
+#define Bitset panda::BitsetFixedSize<6>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<7>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<8>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<10>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
+
+#define Bitset panda::BitsetFixedSize<12>
+#include "fourier_motzkin_phase_two.eti"
+#undef Bitset
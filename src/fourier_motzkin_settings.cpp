@@ -0,0 +1,206 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "fourier_motzkin_settings.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "concurrency.h"
+#include "input_detection.h"
+
+using namespace panda;
+
+namespace
+{
+   /// Reads the strategy of the adjacency test from the command line.
+   AdjacencyTest adjacencyTest(int, char**);
+   /// Reads the data structure of the minimality filter from the command line.
+   PairFilter pairFilter(int, char**);
+   /// Reads the file name of an option "<prefix><file>" from the command line. Returns an empty string if absent.
+   std::string fileOption(int, char**, const char*);
+   /// Reads the time between two checkpoints from the command line.
+   std::chrono::seconds checkpointInterval(int, char**);
+   /// Reads the memory limit in bytes from the command line.
+   std::size_t memoryLimit(int, char**);
+   /// Checks if the command line contains the given option.
+   bool flagOption(int, char**, const char*);
+}
+
+panda::FourierMotzkinSettings::FourierMotzkinSettings() noexcept
+:
+   thread_count(1),
+   for_each(),
+   adjacency_test(AdjacencyTest::Scan),
+   pair_filter(PairFilter::SubsetIndex),
+   insertion_order(InputOrder::NoSorting),
+   checkpoint_file(),
+   checkpoint_interval(std::chrono::minutes(10)),
+   resume_file(),
+   memory_limit(0),
+   stream_output(false),
+   incremental(false)
+{
+}
+
+FourierMotzkinSettings panda::fourierMotzkinSettings(int argc, char** argv)
+{
+   assert( argc > 0 && argv != nullptr );
+   FourierMotzkinSettings settings;
+   settings.thread_count = static_cast<std::size_t>(concurrency::numberOfThreads(argc, argv));
+   settings.adjacency_test = adjacencyTest(argc, argv);
+   settings.pair_filter = pairFilter(argc, argv);
+   settings.insertion_order = getInputOrder(argc, argv);
+   settings.checkpoint_file = fileOption(argc, argv, "--checkpoint=");
+   settings.checkpoint_interval = checkpointInterval(argc, argv);
+   settings.resume_file = fileOption(argc, argv, "--resume=");
+   settings.memory_limit = memoryLimit(argc, argv);
+   settings.stream_output = flagOption(argc, argv, "--stream-output");
+   settings.incremental = flagOption(argc, argv, "--incremental");
+   return settings;
+}
+
+namespace
+{
+   AdjacencyTest adjacencyTest(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--adjacency=", 12) == 0 )
+         {
+            const auto argument = argv[i] + 12;
+            if ( std::strcmp(argument, "scan") == 0 )
+            {
+               return AdjacencyTest::Scan;
+            }
+            if ( std::strcmp(argument, "transposed") == 0 )
+            {
+               return AdjacencyTest::Transposed;
+            }
+            if ( std::strcmp(argument, "algebraic") == 0 )
+            {
+               return AdjacencyTest::Algebraic;
+            }
+            if ( std::strcmp(argument, "auto") == 0 )
+            {
+               return AdjacencyTest::Automatic;
+            }
+            throw std::invalid_argument("Command line option \"--adjacency=<arg>\" needs one of the parameters \"scan\", \"transposed\", \"algebraic\" or \"auto\".");
+         }
+      }
+      return AdjacencyTest::Scan;
+   }
+
+   PairFilter pairFilter(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--pair-filter=", 14) == 0 )
+         {
+            const auto argument = argv[i] + 14;
+            if ( std::strcmp(argument, "list") == 0 )
+            {
+               return PairFilter::List;
+            }
+            if ( std::strcmp(argument, "index") == 0 )
+            {
+               return PairFilter::SubsetIndex;
+            }
+            throw std::invalid_argument("Command line option \"--pair-filter=<arg>\" needs one of the parameters \"list\" or \"index\".");
+         }
+      }
+      return PairFilter::SubsetIndex;
+   }
+
+   std::string fileOption(int argc, char** argv, const char* prefix)
+   {
+      const auto length = std::strlen(prefix);
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], prefix, length) == 0 )
+         {
+            if ( argv[i][length] == '\0' )
+            {
+               throw std::invalid_argument(std::string("Command line option \"") + prefix + "<file>\" needs a file name.");
+            }
+            return argv[i] + length;
+         }
+      }
+      return std::string();
+   }
+
+   std::chrono::seconds checkpointInterval(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--checkpoint-interval=", 22) == 0 )
+         {
+            const auto argument = argv[i] + 22;
+            char* end = nullptr;
+            const auto seconds = std::strtol(argument, &end, 10);
+            if ( end == argument || *end != '\0' || seconds < 0 )
+            {
+               throw std::invalid_argument("Command line option \"--checkpoint-interval=<n>\" needs a non-negative number of seconds.");
+            }
+            return std::chrono::seconds(seconds);
+         }
+      }
+      return std::chrono::minutes(10);
+   }
+
+   std::size_t memoryLimit(int argc, char** argv)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strncmp(argv[i], "--memory-limit=", 15) == 0 )
+         {
+            const auto argument = argv[i] + 15;
+            char* end = nullptr;
+            const auto value = std::strtoull(argument, &end, 10);
+            std::size_t unit = 1;
+            if ( end != argument && *end != '\0' && end[1] == '\0' )
+            {
+               switch ( *end )
+               {
+                  case 'K':
+                     unit = std::size_t(1) << 10;
+                     ++end;
+                     break;
+                  case 'M':
+                     unit = std::size_t(1) << 20;
+                     ++end;
+                     break;
+                  case 'G':
+                     unit = std::size_t(1) << 30;
+                     ++end;
+                     break;
+               }
+            }
+            if ( end == argument || *end != '\0' || *argument == '-' || value == 0 )
+            {
+               throw std::invalid_argument("Command line option \"--memory-limit=<n>\" needs a positive number of bytes, optionally followed by K, M or G.");
+            }
+            return static_cast<std::size_t>(value) * unit;
+         }
+      }
+      return 0;
+   }
+
+   bool flagOption(int argc, char** argv, const char* option)
+   {
+      for ( int i = 1; i < argc; ++i )
+      {
+         if ( std::strcmp(argv[i], option) == 0 )
+         {
+            return true;
+         }
+      }
+      return false;
+   }
+}
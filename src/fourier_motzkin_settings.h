@@ -0,0 +1,66 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "for_each.h"
+#include "input_order.h"
+
+namespace panda
+{
+   /// Strategies to decide whether two rows combine to an adjacent new row.
+   enum class AdjacencyTest
+   {
+      Scan,       /// Scan all rows on the hyperplane for one containing the common zero set.
+      Transposed, /// Intersect per-vertex columns of the rows on the hyperplane.
+      Algebraic,  /// Check that the vertices on both rows have rank d-2.
+      Automatic   /// Choose one of the above in every step by its estimated cost.
+   };
+
+   /// Data structures keeping only the inclusion-minimal candidates for new rows.
+   enum class PairFilter
+   {
+      List, /// Unordered list, every candidate is compared to all others.
+      SubsetIndex /// Candidates bucketed by number of elements, see MinimalSubsetIndex.
+   };
+
+   /// Parameters steering the Fourier-Motzkin elimination.
+   struct FourierMotzkinSettings
+   {
+      /// Default constructor: sequential elimination.
+      FourierMotzkinSettings() noexcept;
+      /// Number of threads used within each projection step.
+      std::size_t thread_count;
+      /// Runs the chunks of the parallel loops of each projection step instead of own threads unless it is empty.
+      /// The loops are split for thread_count threads as before.
+      ForEach for_each;
+      /// Strategy of the adjacency test.
+      AdjacencyTest adjacency_test;
+      /// Data structure of the minimality filter.
+      PairFilter pair_filter;
+      /// Order of insertion. Adaptive orders choose the next vertex in every step, all others keep the given order.
+      InputOrder insertion_order;
+      /// File the state is periodically written to. Empty if no checkpoints are written.
+      std::string checkpoint_file;
+      /// Minimum time between two checkpoints.
+      std::chrono::seconds checkpoint_interval;
+      /// File of a checkpoint to continue from. Empty if the elimination starts from scratch.
+      std::string resume_file;
+      /// Bytes the rows of the system may occupy before they are moved to temporary files. Zero means no limit.
+      std::size_t memory_limit;
+      /// Whether class representatives of the final system are passed to the output batch by batch as they are found.
+      bool stream_output;
+      /// Whether facet enumeration extends the complete facets of a previous result given as known facets.
+      bool incremental;
+   };
+   /// Collects the Fourier-Motzkin settings from the command line.
+   FourierMotzkinSettings fourierMotzkinSettings(int, char**);
+}
+
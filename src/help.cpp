@@ -59,6 +59,82 @@ int panda::help::command(int argc, char** argv)
 
 namespace
 {
+   void printHelpCommandAdjacency()
+   {
+      std::cout << "In each step of the double description method, pairs of rows are combined to new rows only if they are adjacent.\n"
+                << "Adjacency of a pair is decided either combinatorially, by searching for a third row that is tight at all vertices at which the pair is tight,\n"
+                << "or algebraically, by checking that the vertices at which the pair is tight have rank d-2.\n"
+                << "The strategies are available via \"--adjacency=\":\n"
+                << "\tscan: tests every row on the current hyperplane separately (default)\n"
+                << "\ttransposed: keeps per vertex the set of tight rows and intersects these sets, which pays off for highly degenerate input\n"
+                << "\talgebraic: computes the rank of the common tight vertices, which pays off in low dimension with many rows\n"
+                << "\tauto: chooses one of the above in every step by its estimated cost and reports the choice\n"
+                << "All strategies yield identical output.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --adjacency=transposed\n";
+   }
+
+   void printHelpCommandCheckpoint()
+   {
+      std::cout << "Long runs of the double description method can be protected against interruptions by checkpoints.\n"
+                << "With \"--checkpoint=<file>\", the state of the elimination (next step, vertex order, current system and incidences) is written to <file> in a binary format.\n"
+                << "A checkpoint is taken at the start of a step if at least <n> seconds passed since the previous one, where <n> is given by \"--checkpoint-interval=<n>\" (default 600).\n"
+                << "The state is written by a background thread to a temporary file, which then replaces <file>, so <file> always holds a complete checkpoint.\n"
+                << "With \"--resume=<file>\", the elimination continues from the checkpoint and produces the same output as an uninterrupted run.\n"
+                << "The input file, the integer type and the sorting must be the same as in the interrupted run, otherwise the checkpoint is rejected.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --checkpoint=myproblem.checkpoint\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --checkpoint=myproblem.checkpoint --resume=myproblem.checkpoint\n";
+   }
+
+   void printHelpCommandMemoryLimit()
+   {
+      std::cout << "Intermediate systems of the double description method may need much more memory than the final facet list.\n"
+                << "With \"--memory-limit=<n>\", a system whose rows would occupy more than <n> bytes is moved to temporary files.\n"
+                << "The number <n> may be followed by K, M or G for kibibytes, mebibytes or gibibytes.\n"
+                << "In the files, rows are stored in blocks. Each step reads the blocks sequentially and combines negative and positive rows tile by tile,\n"
+                << "a tile being the pairs of one block of negative and one block of positive rows. New rows are written sequentially to the file of the next step.\n"
+                << "The incidences of the rows stay in memory, as they only take one bit per vertex.\n"
+                << "A system returns to memory once it takes less than half of the limit. No checkpoints are written while a system is in files.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --memory-limit=8G\n";
+   }
+
+   void printHelpCommandRecursionThreshold()
+   {
+      std::cout << "Adjacency decomposition rotates each facet around its ridges, which are computed by Fourier-Motzkin elimination on the vertices of the facet.\n"
+                << "For highly degenerate facets with many vertices, this elimination may dominate the run.\n"
+                << "With \"--recursion-threshold=<n>\", the ridges of a facet with more than <n> vertices are computed by adjacency decomposition again.\n"
+                << "The recursion uses the maps that leave the facet unchanged, so only class representatives of the ridges are rotated around.\n"
+                << "The same threshold applies within the recursion. By default (0) there is no recursion. The output does not depend on the threshold.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m ad --recursion-threshold=1000\n";
+   }
+
+   void printHelpCommandRidgeCache()
+   {
+      std::cout << "In symmetric or structured polytopes, the vertices of different facets are often equal up to a permutation of the coordinates.\n"
+                << "With \"--ridge-cache\", adjacency decomposition keeps the ridges computed by Fourier-Motzkin elimination, keyed by the vertices of the facet\n"
+                << "with their coordinates in an order derived from the vertices alone. A facet with the same key gets the stored ridges with its own order of coordinates.\n"
+                << "The cache holds at most 1G of vertices and ridges, \"--ridge-cache=<n>\" sets the limit to <n> bytes (suffixes K, M, G).\n"
+                << "When it is full, the least recently used entries are evicted. With adaptive precision, the two integer types share the limit.\n"
+                << "The number of reused ridge computations and evicted entries is printed at the end of the run. The output does not depend on the cache.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m ad --ridge-cache=256M\n";
+   }
+
+   void printHelpCommandStreamOutput()
+   {
+      std::cout << "The double description method computes all rows of the final system and reduces them to class representatives afterwards.\n"
+                << "By default, all rows are copied into a set, and the classes are taken out of the set in parallel, using the threads given by \"-t\".\n"
+                << "With \"--stream-output\", facet enumeration tests each row of the final system on its own instead.\n"
+                << "Its class is generated only until a greater row is found, which for most rows happens after a few maps.\n"
+                << "The representatives are written batch by batch as soon as they are found, so the output can be consumed before the run ends,\n"
+                << "and the final system is never copied as a whole. The output contains the same representatives, possibly in a different order.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --stream-output\n";
+   }
+
    void printHelpCommandCheck()
    {
       std::cout << "By default, " << project::application_acronym << " assumes the user input to be correct.\n"
@@ -96,10 +172,11 @@ namespace
                 << "To prove correctness, either an arbitrary precision integer type must be used, or it must be asserted that no operation on a fixed width integer type may result in an overflow.\n\n"
                 << "By default " << project::binary_name << " uses a fixed width integer type.\n"
                 << "You may select one of the following options:\n"
-                << "\t16, 32, 64, safe, inf.\n"
+                << "\t16, 32, 64, safe, inf, adaptive.\n"
                 << "As the names suggest, 16, 32 and 64 guarantee fixed with integer arithmetic with 16bit, 32bit and 64bit types respectively.\n"
                 << "\"inf\" will force " << project::binary_name << " to perform every operation with an arbitrary precision integer type. Attention: this will drastically slow down any calculations!\n"
-                << "\"safe\" is a compromise between performance of fixed width integer type and the correctness guarantee. If a calculation results in an overflow, the process is aborted with an error message. All results so far did not suffer from that overflow, so they may be trusted.\n\n"
+                << "\"safe\" is a compromise between performance of fixed width integer type and the correctness guarantee. If a calculation results in an overflow, the process is aborted with an error message. All results so far did not suffer from that overflow, so they may be trusted.\n"
+                << "\"adaptive\" keeps all results with arbitrary precision like \"inf\". The adjacency decomposition computes each job with the \"safe\" type first and repeats only the jobs that overflow with arbitrary precision. The number of repeated jobs is reported at the end. Other methods use \"inf\".\n\n"
                 << "To select one of the integer types, use the command line option \"-i\" / \"--integer-type=\".\n"
                 << "Example usage:\n"
                 << "\t./" << project::binary_name << " myproblem -i safe\n"
@@ -126,7 +203,19 @@ namespace
                 << "You may inform " << project::application_acronym << " of this prior knowledge by using the \"-k\" / \"--known-data=\" / \"--known-facets=\" / \"--known-vertices=\" option.\n"
                 << "Example usage:\n"
                 << "\t./" << project::binary_name << " myproblem -k my_known_inequalities\n"
-                << "\t./" << project::binary_name << " myproblem --known-data=my_known_vertices\n";
+                << "\t./" << project::binary_name << " myproblem --known-data=my_known_vertices\n"
+                << "The double description method only takes known inequalities with \"--incremental\", see \"--help incremental\".\n";
+   }
+
+   void printHelpCommandIncremental()
+   {
+      std::cout << "With \"--incremental\", the double description method takes the known inequalities (\"-k\") as the complete result of a previous facet enumeration,\n"
+                << "e.g. of a subset of the vertices. Only the vertices violating one of them are inserted, so extending a polytope by a few vertices costs just as many elimination steps.\n"
+                << "The previous polytope must be full-dimensional. If maps are given, the known inequalities may be class representatives.\n"
+                << "Each inequality is checked to be a facet of the previous polytope. Whether the facets are complete is not checked,\n"
+                << "as this takes as long as the previous run: with a facet missing, the output is wrong.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --incremental -k my_previous_result\n";
    }
 
    void printHelpCommandMethod()
@@ -143,6 +232,17 @@ namespace
                 << "\t./" << project::binary_name << " myproblem --method=ad\n";
    }
 
+   void printHelpCommandPairFilter()
+   {
+      std::cout << "In each step of the double description method, only inclusion-minimal combinations of rows are kept.\n"
+                << "The data structure of this filter can be chosen via \"--pair-filter=\":\n"
+                << "\tindex: bit-sliced index with fast subset queries (default)\n"
+                << "\tlist: plain list, every new combination is compared to all kept ones\n"
+                << "Both filters yield identical output.\n"
+                << "Example usage:\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --pair-filter=list\n";
+   }
+
    void printHelpCommandSorting()
    {
       std::cout << "An important implementation detail of " << project::application_acronym << " is the usage of double description method (either explicitely wanted by the user, or implicitely used in adjacency decomposition).\n"
@@ -154,17 +254,27 @@ namespace
                 << "\tnonzero_ascending / nz_asc / nz_up: number of non-zero entries per row\n"
                 << "\tnonzero_descending / nz_desc / nz_down: reversed nonzero_ascending\n"
                 << "\treverse / rev: as if the file was read from back to front\n"
+                << "The double description method additionally supports adaptive orders, which choose the next vertex in each step from the remaining ones:\n"
+                << "\tmin-cutoff: the vertex removing the fewest rows of the current system\n"
+                << "\tmax-intersection: the vertex incident to the most rows of the current system\n"
+                << "\tpredicted-min: the vertex with the smallest predicted next system (zero rows + negative rows + expected adjacent pairs)\n"
+                << "With adaptive orders, the predicted and actual number of rows of each step are reported.\n"
+                << "\tportfolio: runs the double description method with all of the above orders and three seeded random permutations, as many at a time as there are threads (\"-t\");\n"
+                << "\t           threads and the memory limit are shared evenly among the runs alive at the same time, further runs start in order when a run is stopped;\n"
+                << "\t           runs whose system is more than four times the size of another's after the same step are stopped, the first run to finish wins and is reported\n"
                 << "Example usage:\n"
                 << "\t./" << project::binary_name << " myproblem -s lex_asc\n"
                 << "\t./" << project::binary_name << " myproblem -s reverse\n"
                 << "\t./" << project::binary_name << " myproblem --sorting=lex_asc\n"
-                << "\t./" << project::binary_name << " myproblem --sorting=reverse\n";
+                << "\t./" << project::binary_name << " myproblem --sorting=reverse\n"
+                << "\t./" << project::binary_name << " myproblem -m dd --sorting=predicted-min\n";
    }
 
    void printHelpCommandThreads()
    {
       std::cout << "Adjacency decomposition (the default algorithm of " << project::application_acronym << ") is a parallel algorithm.\n"
                 << "By default, it uses as many cores your system provides.\n"
+                << "The double description method uses these threads within each Fourier-Motzkin elimination step.\n"
                 << "However, you may still specify a lower or higher number of threads, e.g. to allow other jobs to work simultaneously.\n"
                 << "Use the \"-t\" / \"--threads=\" command. Only positive integral parameters are allowed.\n"
                 << "Example usage:\n"
@@ -185,7 +295,35 @@ namespace
 
    int printHelpCommand(const std::string& command)
    {
-      if ( command == "c" || command == "-c" || command == "check" || command == "--check" )
+      if ( command == "adjacency" || command == "--adjacency" )
+      {
+         printHelpCommandAdjacency();
+      }
+      else if ( command == "checkpoint" || command == "--checkpoint" || command == "resume" || command == "--resume" || command == "--checkpoint-interval" )
+      {
+         printHelpCommandCheckpoint();
+      }
+      else if ( command == "memory-limit" || command == "--memory-limit" )
+      {
+         printHelpCommandMemoryLimit();
+      }
+      else if ( command == "recursion-threshold" || command == "--recursion-threshold" )
+      {
+         printHelpCommandRecursionThreshold();
+      }
+      else if ( command == "ridge-cache" || command == "--ridge-cache" )
+      {
+         printHelpCommandRidgeCache();
+      }
+      else if ( command == "incremental" || command == "--incremental" )
+      {
+         printHelpCommandIncremental();
+      }
+      else if ( command == "stream-output" || command == "--stream-output" )
+      {
+         printHelpCommandStreamOutput();
+      }
+      else if ( command == "c" || command == "-c" || command == "check" || command == "--check" )
       {
          printHelpCommandCheck();
       }
@@ -205,6 +343,10 @@ namespace
       {
          printHelpCommandMethod();
       }
+      else if ( command == "pair-filter" || command == "--pair-filter" )
+      {
+         printHelpCommandPairFilter();
+      }
       else if ( command == "s" || command == "-s" || command == "sorting" || command == "--sorting" )
       {
          printHelpCommandSorting();
@@ -426,6 +426,11 @@ namespace
             std::reverse(matrix.begin(), matrix.end());
             return;
          }
+         // adaptive orders and the portfolio are applied by the double description method itself.
+         case InputOrder::MinCutoff:
+         case InputOrder::MaxIntersection:
+         case InputOrder::PredictedMin:
+         case InputOrder::Portfolio:
          case InputOrder::NoSorting:
          {
             return;
@@ -82,7 +82,7 @@ InputOrder panda::getInputOrder(int argc, char** argv)
       {
          return inputOrder(argv[i] + 10);
       }
-      else if ( std::strncmp(argv[i], "-s", 2) == 0 || std::strncmp(argv[i], "--s", 3) == 0 )
+      else if ( std::strncmp(argv[i], "-s", 2) == 0 || ( std::strncmp(argv[i], "--s", 3) == 0 && std::strcmp(argv[i], "--stream-output") != 0 ) )
       {
          throw std::invalid_argument("Illegal parameter. Did you mean \"-s <order>\" or \"--sorting=<order>\"?");
       }
@@ -220,6 +220,22 @@ namespace
       {
          return InputOrder::Reverse;
       }
+      if ( std::strcmp(argument, "min-cutoff") == 0 )
+      {
+         return InputOrder::MinCutoff;
+      }
+      if ( std::strcmp(argument, "max-intersection") == 0 )
+      {
+         return InputOrder::MaxIntersection;
+      }
+      if ( std::strcmp(argument, "predicted-min") == 0 )
+      {
+         return InputOrder::PredictedMin;
+      }
+      if ( std::strcmp(argument, "portfolio") == 0 )
+      {
+         return InputOrder::Portfolio;
+      }
       throw std::invalid_argument("Expected an argument to option \"--sorting\".\n");
    }
 
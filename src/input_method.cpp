@@ -36,7 +36,7 @@ Method panda::input::method(int argc, char** argv)
       {
          return detectMethod(argv[i] + 9);
       }
-      else if ( std::strncmp(argv[i], "-m", 2) == 0 || std::strncmp(argv[i], "--m", 3) == 0 )
+      else if ( std::strncmp(argv[i], "-m", 2) == 0 || ( std::strncmp(argv[i], "--m", 3) == 0 && std::strncmp(argv[i], "--memory-limit=", 15) != 0 ) )
       {
          throw std::invalid_argument("Illegal parameter. Did you mean \"-m <method>\" or \"--method=<method>\"?");
       }
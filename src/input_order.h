@@ -15,7 +15,11 @@ namespace panda
       LexicographicDescending,  /// Sort as in a backwards dictionary.
       NonZeroEntriesAscending,  /// Sort by amount of non-zero entries.
       NonZeroEntriesDescending, /// Sort by amount of zero-entries.
-      Reverse                   /// Simply reverse the original order.
+      Reverse,                  /// Simply reverse the original order.
+      MinCutoff,                /// Adaptive: in each step of the double description method, insert the vertex removing the fewest rows.
+      MaxIntersection,          /// Adaptive: in each step of the double description method, insert the vertex incident to the most rows.
+      PredictedMin,             /// Adaptive: in each step of the double description method, insert the vertex with the smallest predicted system.
+      Portfolio                 /// Run the double description method with several of the above orders concurrently and keep the first to finish.
    };
 }
 
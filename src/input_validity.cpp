@@ -15,12 +15,15 @@
 #include "algorithm_inequality_operations.h"
 #include "algorithm_map_operations.h"
 #include "algorithm_matrix_operations.h"
+#include "algorithm_modular_rank.h"
 #include "algorithm_row_operations.h"
 
 using namespace panda;
 
 namespace
 {
+   /// Dimension of a set of rows. The modular rank cannot overflow, exact elimination is only the fallback.
+   std::size_t rank(const Matrix<int>&);
    bool inequalityIsValid(const Matrix<int>&, const Inequality<int>&, const std::size_t);
    void checkValidityOfInequality(const Matrix<int>&, const Inequality<int>&, const std::size_t);
    void checkValidityOfVertex(const Matrix<int>&, const Vertex<int>&, const std::size_t);
@@ -35,7 +38,7 @@ void panda::input::implementation::checkValidityOfInequalities(const Matrix<int>
    {
       return;
    }
-   const auto dimension = algorithm::dimension(matrix);
+   const auto dimension = ::rank(matrix);
    for ( const auto& inequality : inequalities )
    {
       ::checkValidityOfInequality(matrix, inequality, dimension);
@@ -49,7 +52,7 @@ void panda::input::implementation::checkValidityOfVertices(const Matrix<int>& ma
    {
       return;
    }
-   const auto dimension = algorithm::dimension(matrix);
+   const auto dimension = ::rank(matrix);
    for ( const auto& vertex : vertices )
    {
       ::checkValidityOfVertex(matrix, vertex, dimension);
@@ -81,7 +84,7 @@ void panda::input::implementation::filterInvalidInequalities(const Matrix<int>&
    {
       return;
    }
-   const auto dimension = algorithm::dimension(matrix);
+   const auto dimension = ::rank(matrix);
    for ( auto it = inequalities.begin(); it != inequalities.end(); )
    {
       const auto& inequality = *it;
@@ -128,6 +131,12 @@ bool panda::input::filterInvalidInput(int argc, char** argv) noexcept
 
 namespace
 {
+   std::size_t rank(const Matrix<int>& matrix)
+   {
+      const auto modular = algorithm::modularRank(matrix);
+      return modular.second ? modular.first : algorithm::dimension(matrix);
+   }
+
    bool inequalityIsValid(const Matrix<int>& matrix, const Inequality<int>& inequality, const std::size_t dimension)
    {
       // identify vertices and rays that satisfy the inequality with equality
@@ -146,7 +155,7 @@ namespace
          }
       }
       // The resulting set of active vertices must be non-empty and have the correct dimension.
-      return !active.empty() && (algorithm::dimension(active) + 1 == dimension);
+      return !active.empty() && (rank(active) + 1 == dimension);
    }
 
    void checkValidityOfInequality(const Matrix<int>& matrix, const Inequality<int>& inequality, const std::size_t dimension)
@@ -174,7 +183,7 @@ namespace
          stream << "The inequality " << inequality << " is a valid inequality, but does not define a facet, as it is a strict inequality.";
          throw std::invalid_argument(stream.str());
       }
-      if ( algorithm::dimension(active) + 1 != dimension )
+      if ( rank(active) + 1 != dimension )
       {
          std::stringstream stream;
          stream << "The inequality " << inequality << " is not a facet, but only a lower-dimensional face.";
@@ -205,7 +214,7 @@ namespace
          stream << "The row " << vertex << " is a valid vector, but is not extremal.";
          throw std::invalid_argument(stream.str());
       }
-      if ( algorithm::dimension(active) + 1 != dimension )
+      if ( rank(active) + 1 != dimension )
       {
          std::stringstream stream;
          stream << "The row " << vertex << " is not extremal.";
@@ -15,6 +15,7 @@ namespace panda
       Fixed64,  /// Guaranteed 64bit integer.
       Safe,     /// 64bit integer that throws an exception if an operation is unsafe.
       Variable, /// Arbitrary precision integer type (BigInteger).
+      Adaptive, /// Arbitrary precision integer type, adjacency decomposition computes each job with the safe type first.
       Default   /// Integer type that the system uses as "int".
    };
 }
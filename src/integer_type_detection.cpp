@@ -29,7 +29,7 @@ IntegerType panda::integerType(int argc, char** argv)
          if ( i + 1 == argc )
          {
             std::string message = "Command line option -i needs a parameter:";
-            message += " Choose either \"16\", \"32\", \"64\", \"safe\" or \"inf\"-";
+            message += " Choose either \"16\", \"32\", \"64\", \"safe\", \"inf\" or \"adaptive\"-";
             throw std::invalid_argument(message);
          }
          return integerTypeFromString(argv[i + 1]);
@@ -42,7 +42,7 @@ IntegerType panda::integerType(int argc, char** argv)
       {
          return integerTypeFromString(argv[i] + 15);
       }
-      else if ( std::strncmp(argv[i], "-i", 2) == 0 || std::strncmp(argv[i], "--i", 3) == 0 )
+      else if ( std::strncmp(argv[i], "-i", 2) == 0 || ( std::strncmp(argv[i], "--i", 3) == 0 && std::strcmp(argv[i], "--incremental") != 0 ) )
       {
          throw std::invalid_argument("Illegal parameter. Did you mean \"-i <type>\" or \"--integer-type=<type>\"?");
       }
@@ -86,8 +86,12 @@ namespace
       {
          return IntegerType::Variable;
       }
+      else if ( std::strcmp(string, "adaptive") == 0 )
+      {
+         return IntegerType::Adaptive;
+      }
       std::string message = "Invalid parameter to command line option -i";
-      message += " / --integer-type: Choose either \"16\", \"32\", \"64\", \"safe\" or \"inf\"-";
+      message += " / --integer-type: Choose either \"16\", \"32\", \"64\", \"safe\", \"inf\" or \"adaptive\"-";
       throw std::invalid_argument(message);
    }
 }
@@ -55,6 +55,7 @@ int panda::IntegerTypeSelector<Functor>::select(int argc, char** argv)
          return Functor<SafeInteger>::call(argc, argv);
       }
       case IntegerType::Variable:
+      case IntegerType::Adaptive:
       {
          return Functor<BigInteger>::call(argc, argv);
       }
@@ -64,21 +64,52 @@ namespace
       printVersion();
       std::cerr << "Commands:\n"
                 << "\t-i <n>\n\t--integer-type=<n>\n"
-                << "\t\twith <n> being \"16\", \"32\", \"64\", \"safe\" or \"inf\".\n"
+                << "\t\twith <n> being \"16\", \"32\", \"64\", \"safe\", \"inf\" or \"adaptive\".\n"
                 << '\n'
                 << "\t-k <path/to/file>\n\t--known-data=<path/to/file>\n\t--known-facets=<path/to/file>\n\t--known-vertices=<path/to/file>\n"
-                << "\t\toptional way to provide initial data to the adjacency decomposition.\n"
+                << "\t\toptional way to provide initial data to the adjacency decomposition,\n"
+                << "\t\tor, with \"--incremental\", a previous result to extend by the double description method.\n"
                 << '\n'
                 << "\t-m <method>\n\t--method=<method>\n"
                 << "\t\twith <method> being either \"adjacency-decomposition\" (\"ad\", default)\n"
                 << "\t\t                        or \"double-description\" (\"dd\")\n"
                 << '\n'
+                << "\t--adjacency=<arg>\n"
+                << "\t\twith <arg> being \"scan\" (default), \"transposed\", \"algebraic\" or \"auto\", the adjacency test of the double description method.\n"
+                << '\n'
+                << "\t--pair-filter=<arg>\n"
+                << "\t\twith <arg> being \"index\" (default) or \"list\", the minimality filter of the double description method.\n"
+                << '\n'
+                << "\t--checkpoint=<path/to/file>\n\t--checkpoint-interval=<n>\n"
+                << "\t\tperiodically saves the state of the double description method, at most every <n> seconds (default 600).\n"
+                << '\n'
+                << "\t--resume=<path/to/file>\n"
+                << "\t\tcontinues the double description method from a checkpoint.\n"
+                << '\n'
+                << "\t--memory-limit=<n>\n"
+                << "\t\tmoves intermediate systems of the double description method exceeding <n> bytes (suffixes K, M, G) to temporary files.\n"
+                << '\n'
+                << "\t--recursion-threshold=<n>\n"
+                << "\t\tcomputes the ridges of facets with more than <n> vertices by adjacency decomposition again (default 0, never).\n"
+                << '\n'
+                << "\t--ridge-cache[=<n>]\n"
+                << "\t\treuses the ridges of facets whose vertices are equal up to a permutation of the coordinates in adjacency decomposition,\n"
+                << "\t\tkeeping at most <n> bytes (suffixes K, M, G, default 1G).\n"
+                << '\n'
+                << "\t--incremental\n"
+                << "\t\textends the complete facets of a previous result given by \"-k\" by new vertices with the double description method.\n"
+                << '\n'
+                << "\t--stream-output\n"
+                << "\t\twrites the class representatives of facet enumeration with the double description method as they are found.\n"
+                << '\n'
                 << "\t-s <arg>\n\t--sorting=<arg>\n"
                 << "\t\twith <arg> being \"lex_asc\" / \"lexicographic_ascending\"\n"
                 << "\t\t              or \"lex_desc\" / \"lexicographic_descending\"\n"
                 << "\t\t              or \"nz_asc\" / \"nonzero_ascending\"\n"
                 << "\t\t              or \"nz_desc\" / \"nonzero_descending\"\n"
-                << "\t\t              or \"rev\" / \"reverse\".\n"
+                << "\t\t              or \"rev\" / \"reverse\"\n"
+                << "\t\t              or \"min-cutoff\" or \"max-intersection\" or \"predicted-min\" (adaptive, double description only)\n"
+                << "\t\t              or \"portfolio\" (all of the above concurrently, double description only).\n"
                 << '\n'
                 << "\t-c\n\t--check\n"
                 << "\t\tenables check if input is valid (e.g. checks if maps are actually bijections).\n"
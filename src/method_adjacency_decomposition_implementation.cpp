@@ -10,19 +10,27 @@
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
+#include <functional>
 #include <future>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <mutex>
 
+#include "adaptive_precision.h"
+#include "adjacency_decomposition_settings.h"
 #include "algorithm_classes.h"
 #include "algorithm_fourier_motzkin_elimination.h"
 #include "algorithm_map_operations.h"
 #include "algorithm_matrix_operations.h"
 #include "algorithm_rotation.h"
 #include "algorithm_row_operations.h"
-#include "concurrency.h"
+#include "big_integer.h"
 #include "joining_thread.h"
 #include "message_passing_interface_session.h"
+#include "ridge_cache.h"
+#include "work_stealing_pool.h"
 
 using namespace panda;
 
@@ -45,13 +53,31 @@ namespace
 
    template <typename Integer, typename TagType>
    std::future<void> initializePool(JobManagerProxy<Integer, TagType>&, const Matrix<Integer>&, const Maps&, const Matrix<Integer>&, const Equations<Integer>&);
+
+   /// Adaptive precision needs arbitrary precision rows, with any other integer type the jobs are computed as they are.
+   template <typename Integer>
+   std::unique_ptr<AdaptivePrecision> adaptivePrecision(const Matrix<Integer>&, const AdjacencyDecompositionSettings&);
+
+   /// Returns the adjacent rows of a job.
+   template <typename Integer, typename TagType>
+   Matrix<Integer> neighbours(const Matrix<Integer>&, const Row<Integer>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<Integer>*, AdaptivePrecision*);
+
+   #ifndef NO_FLEXIBILITY
+   /// Returns the state of adaptive precision if it is selected.
+   std::unique_ptr<AdaptivePrecision> adaptivePrecision(const Matrix<BigInteger>&, const AdjacencyDecompositionSettings&);
+
+   /// Returns the adjacent rows of a job, with adaptive precision if it is selected.
+   template <typename TagType>
+   Matrix<BigInteger> neighbours(const Matrix<BigInteger>&, const Row<BigInteger>&, const Maps&, TagType, const AdjacencyDecompositionSettings&, const algorithm::ForEach&, RidgeCache<BigInteger>*, AdaptivePrecision*);
+   #endif
 }
 
 template <template <typename, typename> class JobManagerType, typename Integer, typename TagType>
 void panda::implementation::adjacencyDecomposition(int argc, char** argv, const std::tuple<Matrix<Integer>, Names, Maps, Matrix<Integer>>& data, TagType tag)
 {
    const auto node_count = mpi::getSession().getNumberOfNodes();
-   const auto thread_count = concurrency::numberOfThreads(argc, argv);
+   const auto settings = adjacencyDecompositionSettings(argc, argv);
+   const auto thread_count = static_cast<int>(settings.thread_count);
    const auto& input = std::get<0>(data);
    const auto& names = std::get<1>(data);
    const auto& known_output = std::get<3>(data);
@@ -59,25 +85,90 @@ void panda::implementation::adjacencyDecomposition(int argc, char** argv, const
    const auto reduced_data = reduce(job_manager, data);
    const auto& equations = std::get<0>(reduced_data);
    const auto& maps = std::get<1>(reduced_data);
-   std::list<JoiningThread> threads;
-   auto future = initializePool(job_manager, input, maps, known_output, equations);
-   for ( int i = 0; i < thread_count; ++i )
+   // workers waiting for a job steal rotations around single ridges from the jobs of the others.
+   WorkStealingPool pool(settings.thread_count);
+   const algorithm::ForEach for_each = [&pool](const std::size_t size, const std::function<void(std::size_t)>& function)
+   {
+      pool.run(size, function);
+   };
+   const auto adaptive = adaptivePrecision(input, settings);
+   // with adaptive precision, the caches of both integer types share the limit.
+   RidgeCache<Integer> cache(adaptive ? settings.ridge_cache_limit / 2 : settings.ridge_cache_limit);
+   // the first exception of a worker, rethrown after all workers finished.
+   std::mutex exception_mutex;
+   std::exception_ptr exception;
    {
-      threads.emplace_front([&]()
+      std::list<JoiningThread> threads;
+      auto future = initializePool(job_manager, input, maps, known_output, equations);
+      for ( int i = 0; i < thread_count; ++i )
       {
-         while ( true )
+         threads.emplace_front([&]()
          {
-            const auto job = job_manager.get();
-            if ( job.empty() )
+            while ( true )
             {
-               break;
+               pool.idle();
+               const auto job = job_manager.get();
+               pool.busy();
+               if ( job.empty() )
+               {
+                  break;
+               }
+               {
+                  const std::lock_guard<std::mutex> lock(exception_mutex);
+                  if ( exception )
+                  {
+                     // after a failure, the remaining jobs are taken without computing their neighbours.
+                     job_manager.put(Matrix<Integer>{});
+                     continue;
+                  }
+               }
+               try
+               {
+                  const auto jobs = neighbours(input, job, maps, tag, settings, for_each, settings.ridge_cache ? &cache : nullptr, adaptive.get());
+                  job_manager.put(jobs);
+               }
+               catch ( ... )
+               {
+                  {
+                     const std::lock_guard<std::mutex> lock(exception_mutex);
+                     if ( !exception )
+                     {
+                        exception = std::current_exception();
+                     }
+                  }
+                  job_manager.put(Matrix<Integer>{});
+               }
             }
-            const auto jobs = algorithm::rotation(input, job, maps, tag);
-            job_manager.put(jobs);
-         }
-      });
+         });
+      }
+      future.wait();
+   }
+   if ( exception )
+   {
+      std::rethrow_exception(exception);
+   }
+   if ( settings.ridge_cache )
+   {
+      auto lookups = cache.lookups();
+      auto hits = cache.hits();
+      auto evictions = cache.evictions();
+      if ( adaptive )
+      {
+         lookups += adaptive->ridgeCache().lookups();
+         hits += adaptive->ridgeCache().hits();
+         evictions += adaptive->ridgeCache().evictions();
+      }
+      std::cerr << "Ridge cache: " << hits << " of " << lookups << " ridge computations reused";
+      if ( lookups > 0 )
+      {
+         std::cerr << " (" << 100 * hits / lookups << " %)";
+      }
+      std::cerr << ", " << evictions << " entries evicted.\n";
+   }
+   if ( adaptive )
+   {
+      std::cerr << "Adaptive precision: " << adaptive->promotions() << " of " << adaptive->jobs() << " jobs repeated with arbitrary precision.\n";
    }
-   future.wait();
 }
 
 namespace
@@ -179,5 +270,38 @@ namespace
       auto future = std::async(std::launch::async, [](){});
       return future;
    }
+
+   template <typename Integer>
+   std::unique_ptr<AdaptivePrecision> adaptivePrecision(const Matrix<Integer>&, const AdjacencyDecompositionSettings&)
+   {
+      return nullptr;
+   }
+
+   template <typename Integer, typename TagType>
+   Matrix<Integer> neighbours(const Matrix<Integer>& input, const Row<Integer>& job, const Maps& maps, TagType tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<Integer>* const cache, AdaptivePrecision*)
+   {
+      return algorithm::rotation(input, job, maps, tag, settings, for_each, cache);
+   }
+
+   #ifndef NO_FLEXIBILITY
+   std::unique_ptr<AdaptivePrecision> adaptivePrecision(const Matrix<BigInteger>& input, const AdjacencyDecompositionSettings& settings)
+   {
+      if ( !settings.adaptive_precision )
+      {
+         return nullptr;
+      }
+      return std::unique_ptr<AdaptivePrecision>(new AdaptivePrecision(input, settings.ridge_cache_limit / 2));
+   }
+
+   template <typename TagType>
+   Matrix<BigInteger> neighbours(const Matrix<BigInteger>& input, const Row<BigInteger>& job, const Maps& maps, TagType tag, const AdjacencyDecompositionSettings& settings, const algorithm::ForEach& for_each, RidgeCache<BigInteger>* const cache, AdaptivePrecision* const adaptive)
+   {
+      if ( adaptive != nullptr )
+      {
+         return adaptive->rotation(job, maps, tag, settings, for_each, cache);
+      }
+      return algorithm::rotation(input, job, maps, tag, settings, for_each, cache);
+   }
+   #endif
 }
 
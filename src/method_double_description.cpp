@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <exception>
 #include <iostream>
+#include <set>
+#include <stdexcept>
 
 #include "algorithm_classes.h"
 #include "algorithm_fourier_motzkin_elimination.h"
@@ -16,6 +18,7 @@
 #include "algorithm_matrix_operations.h"
 #include "algorithm_row_operations.h"
 #include "application_name.h"
+#include "fourier_motzkin_settings.h"
 #include "input.h"
 #include "integer_type_selection.h"
 
@@ -124,6 +127,18 @@ namespace
       algorithm::prettyPrint(std::cout, inequalities, names, "<=");
    }
 
+   template <typename Integer>
+   Matrix<Integer> expandClasses(const Matrix<Integer>& rows, const Maps& maps)
+   {
+      std::set<Row<Integer>> expanded;
+      for ( const auto& row : rows )
+      {
+         const auto row_class = algorithm::getClass(row, maps, tag::facet{});
+         expanded.insert(row_class.cbegin(), row_class.cend());
+      }
+      return Matrix<Integer>(expanded.cbegin(), expanded.cend());
+   }
+
    template <typename Integer>
    int FacetEnumerationDoubleDescription<Integer>::call(int argc, char** argv)
    try
@@ -134,6 +149,7 @@ namespace
       const auto& vertices = std::get<0>(data);
       const auto& names = std::get<1>(data);
       const auto& maps = std::get<2>(data);
+      const auto& known_facets = std::get<3>(data);
       // computation part 1: identifying equations
       const auto equations = algorithm::extractEquations(vertices);
       const auto reduced_maps = algorithm::normalize(maps, equations);
@@ -144,10 +160,48 @@ namespace
          std::cout << '\n';
       }
       // computation part 2: identifying inequalities
-      auto inequalities = algorithm::fourierMotzkinElimination(vertices);
-      inequalities = algorithm::classes(inequalities, reduced_maps, tag::facet{});
-      // output
+      const auto settings = fourierMotzkinSettings(argc, argv);
       const auto is_reduced = !maps.empty();
+      // partial known facets, as for adjacency decomposition, would silently yield a wrong result.
+      if ( !known_facets.empty() && !settings.incremental )
+      {
+         throw std::invalid_argument("The double description method takes known facets (\"-k\") only as the complete result of a previous run, which needs option \"--incremental\".");
+      }
+      if ( known_facets.empty() && settings.incremental )
+      {
+         throw std::invalid_argument("Option \"--incremental\" needs the facets of a previous result (\"-k\").");
+      }
+      if ( known_facets.empty() && settings.stream_output )
+      {
+         // representatives are written batch by batch as they are found.
+         if ( is_reduced )
+         {
+            std::cout << "Reduced ";
+         }
+         std::cout << "Inequalities:\n";
+         algorithm::fourierMotzkinElimination<Integer>(vertices, settings, reduced_maps, tag::facet{}, [&names](const Matrix<Integer>& rows)
+         {
+            algorithm::prettyPrint(std::cout, rows, names, "<=");
+            std::cout.flush();
+         });
+         return 0;
+      }
+      Matrix<Integer> inequalities;
+      if ( !known_facets.empty() )
+      {
+         if ( settings.stream_output )
+         {
+            throw std::invalid_argument("Option \"--stream-output\" cannot be combined with \"--incremental\".");
+         }
+         // a previous result: its classes are expanded, only the vertices outside of it are inserted.
+         const auto previous = algorithm::fourierMotzkinEliminationIncremental(vertices, expandClasses(known_facets, reduced_maps), settings);
+         inequalities = algorithm::classes(previous, reduced_maps, tag::facet{}, settings.thread_count);
+      }
+      else
+      {
+         inequalities = algorithm::classes(algorithm::fourierMotzkinElimination(vertices, settings), reduced_maps, tag::facet{}, settings.thread_count);
+      }
+      // output
       print(std::move(inequalities), std::move(names), is_reduced);
       return 0;
    }
@@ -172,8 +226,12 @@ namespace
       const auto& inequalities = std::get<0>(data);
       const auto& maps = std::get<2>(data);
       // computation: identifying extremal vertices and rays
-      auto matrix = algorithm::fourierMotzkinElimination(inequalities);
-      matrix = algorithm::classes(matrix, maps, tag::vertex{});
+      const auto settings = fourierMotzkinSettings(argc, argv);
+      if ( settings.incremental )
+      {
+         throw std::invalid_argument("Option \"--incremental\" is only supported by facet enumeration.");
+      }
+      auto matrix = algorithm::classes(algorithm::fourierMotzkinElimination(inequalities, settings), maps, tag::vertex{}, settings.thread_count);
       // output
       const auto is_reduced = !maps.empty();
       print(std::move(matrix), is_reduced);
@@ -0,0 +1,51 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace panda
+{
+   /// Returns the positions in [0, max) that are not set in the bitset.
+   /// Bitsets which can enumerate these positions faster than by testing every bit provide an overload.
+   template <typename Bitset>
+   std::vector<std::size_t> unsetBits(const Bitset&, const std::size_t);
+
+   /// Keeps the inclusion-minimal bitsets of everything inserted, each with an associated value.
+   /// Of several equal bitsets, the one inserted first is kept.
+   ///
+   /// The bitsets are stored bit-sliced in blocks of 64: per block and bit position there is one word
+   /// marking the bitsets of the block that do not contain this bit. A subset of a bitset u must miss
+   /// every bit u misses, so the query intersects the words of these bits and stops as soon as the
+   /// block is exhausted, which usually happens after very few words.
+   /// Proper supersets are not removed on insertion. They cannot change the outcome of later insertions
+   /// (their subset is present as well) and are filtered once in release().
+   template <typename Bitset, typename Value>
+   class MinimalSubsetIndex
+   {
+      public:
+         /// Constructor: argument is the hint of highest set bit used in all bitset operations.
+         explicit MinimalSubsetIndex(const std::size_t);
+         /// Inserts the bitset unless an equal bitset or a subset is present. Returns true if the bitset was inserted.
+         bool insert(const Bitset&, const Value&);
+         /// Returns all minimal bitsets with their values in order of insertion and clears the index.
+         std::vector<std::pair<Bitset, Value>> release();
+      private:
+         using Word = uint64_t;
+         /// Checks if a stored bitset other than the excluded one misses all the given positions.
+         bool containsSubset(const std::vector<std::size_t>&, const std::size_t) const noexcept;
+         std::size_t max;
+         std::vector<std::pair<Bitset, Value>> entries;
+         std::vector<Word> slices;
+   };
+}
+
+#include "minimal_subset_index.tpp"
+
@@ -0,0 +1,107 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <cassert>
+#include <limits>
+
+template <typename Bitset, typename Value>
+panda::MinimalSubsetIndex<Bitset, Value>::MinimalSubsetIndex(const std::size_t max_)
+:
+   max(max_),
+   entries(),
+   slices()
+{
+}
+
+template <typename Bitset, typename Value>
+bool panda::MinimalSubsetIndex<Bitset, Value>::insert(const Bitset& bitset, const Value& value)
+{
+   const auto digits = static_cast<std::size_t>(std::numeric_limits<Word>::digits);
+   const auto unset = unsetBits(bitset, max);
+   if ( containsSubset(unset, entries.size()) )
+   {
+      return false;
+   }
+   const auto position = entries.size();
+   if ( position % digits == 0 )
+   {
+      slices.resize(slices.size() + max, 0);
+   }
+   const auto block = position / digits;
+   const auto mask = static_cast<Word>(1u) << (position % digits);
+   for ( const auto i : unset )
+   {
+      slices[block * max + i] |= mask;
+   }
+   entries.emplace_back(bitset, value);
+   return true;
+}
+
+template <typename Bitset, typename Value>
+std::vector<std::pair<Bitset, Value>> panda::MinimalSubsetIndex<Bitset, Value>::release()
+{
+   std::vector<std::pair<Bitset, Value>> result;
+   std::vector<char> is_minimal(entries.size());
+   for ( std::size_t k = 0; k < entries.size(); ++k )
+   {
+      is_minimal[k] = !containsSubset(unsetBits(entries[k].first, max), k);
+   }
+   for ( std::size_t k = 0; k < entries.size(); ++k )
+   {
+      if ( is_minimal[k] )
+      {
+         result.push_back(std::move(entries[k]));
+      }
+   }
+   entries.clear();
+   slices.clear();
+   return result;
+}
+
+template <typename Bitset>
+std::vector<std::size_t> panda::unsetBits(const Bitset& bitset, const std::size_t max)
+{
+   std::vector<std::size_t> result;
+   for ( std::size_t i = 0; i < max; ++i )
+   {
+      if ( !bitset.test(i) )
+      {
+         result.push_back(i);
+      }
+   }
+   return result;
+}
+
+template <typename Bitset, typename Value>
+bool panda::MinimalSubsetIndex<Bitset, Value>::containsSubset(const std::vector<std::size_t>& unset, const std::size_t excluded) const noexcept
+{
+   // stored bitsets are pairwise different, so any other stored subset is a proper subset.
+   const auto digits = static_cast<std::size_t>(std::numeric_limits<Word>::digits);
+   const auto blocks = (entries.size() + digits - 1) / digits;
+   for ( std::size_t block = 0; block < blocks; ++block )
+   {
+      auto candidates = ~static_cast<Word>(0u);
+      if ( block + 1 == blocks && entries.size() % digits != 0 )
+      {
+         candidates = (static_cast<Word>(1u) << (entries.size() % digits)) - 1;
+      }
+      if ( excluded / digits == block )
+      {
+         candidates &= ~(static_cast<Word>(1u) << (excluded % digits));
+      }
+      const auto offset = block * max;
+      for ( auto it = unset.cbegin(); it != unset.cend() && candidates != 0; ++it )
+      {
+         candidates &= slices[offset + *it];
+      }
+      if ( candidates != 0 )
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
@@ -0,0 +1,23 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "parallel_for.h"
+
+#include <algorithm>
+
+using namespace panda;
+
+std::size_t panda::chunkCount(const std::size_t size, const std::size_t thread_count) noexcept
+{
+   // more chunks than threads compensate for unequal work per chunk
+   const std::size_t chunks_per_thread = 4;
+   if ( thread_count <= 1 )
+   {
+      return std::min<std::size_t>(size, 1);
+   }
+   return std::min(size, thread_count * chunks_per_thread);
+}
+
@@ -0,0 +1,31 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+
+#include "for_each.h"
+
+namespace panda
+{
+   /// Returns the number of chunks parallelFor splits a range of the given size into.
+   std::size_t chunkCount(std::size_t, std::size_t) noexcept;
+   /// Splits the index range [0, size) into chunkCount(size, thread_count) contiguous chunks
+   /// and calls function(chunk, begin, end) once per chunk, using up to thread_count threads.
+   /// Chunks are handed out dynamically, but chunk c always covers the same index range,
+   /// so per-chunk results can be combined in chunk order deterministically.
+   /// The first exception thrown by any chunk is rethrown after all threads finished.
+   template <typename Function>
+   void parallelFor(std::size_t, std::size_t, Function&&);
+   /// As above, the chunks are tasks handed to the given ForEach (e.g. of a thread pool) instead of own threads,
+   /// unless it is empty.
+   template <typename Function>
+   void parallelFor(std::size_t, std::size_t, const ForEach&, Function&&);
+}
+
+#include "parallel_for.tpp"
+
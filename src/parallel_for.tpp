@@ -0,0 +1,82 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "joining_thread.h"
+
+template <typename Function>
+void panda::parallelFor(const std::size_t size, const std::size_t thread_count, Function&& function)
+{
+   const auto chunk_count = chunkCount(size, thread_count);
+   if ( chunk_count == 0 )
+   {
+      return;
+   }
+   const auto chunkBegin = [size, chunk_count](const std::size_t chunk)
+   {
+      return (size / chunk_count) * chunk + std::min(chunk, size % chunk_count);
+   };
+   if ( chunk_count == 1 )
+   {
+      function(std::size_t(0), std::size_t(0), size);
+      return;
+   }
+   std::atomic<std::size_t> next_chunk(0);
+   std::vector<std::exception_ptr> exceptions(chunk_count);
+   const auto work = [&]()
+   {
+      for ( auto chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++ )
+      {
+         try
+         {
+            function(chunk, chunkBegin(chunk), chunkBegin(chunk + 1));
+         }
+         catch ( ... )
+         {
+            exceptions[chunk] = std::current_exception();
+         }
+      }
+   };
+   {
+      std::list<JoiningThread> threads;
+      for ( std::size_t t = 1; t < std::min(thread_count, chunk_count); ++t )
+      {
+         threads.emplace_front(work);
+      }
+      work();
+   }
+   for ( const auto& exception : exceptions )
+   {
+      if ( exception )
+      {
+         std::rethrow_exception(exception);
+      }
+   }
+}
+
+template <typename Function>
+void panda::parallelFor(const std::size_t size, const std::size_t thread_count, const ForEach& for_each, Function&& function)
+{
+   const auto chunk_count = chunkCount(size, thread_count);
+   if ( !for_each || chunk_count <= 1 )
+   {
+      parallelFor(size, thread_count, std::forward<Function>(function));
+      return;
+   }
+   // the chunks are the same as with own threads, so are results combined in chunk order.
+   for_each(chunk_count, [&](const std::size_t chunk)
+   {
+      const auto begin = (size / chunk_count) * chunk + std::min(chunk, size % chunk_count);
+      const auto end = (size / chunk_count) * (chunk + 1) + std::min(chunk + 1, size % chunk_count);
+      function(chunk, begin, end);
+   });
+}
@@ -12,6 +12,8 @@ namespace panda
 {
    /// returns the number of active bits in an unsigned integer.
    inline int popcount(uint32_t) noexcept;
+   /// returns the number of active bits in an unsigned integer.
+   inline int popcount(uint64_t) noexcept;
 }
 
 #include "popcount.tpp"
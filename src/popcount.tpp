@@ -20,6 +20,11 @@ namespace panda
          static_assert(std::is_same<uint32_t, unsigned int>::value, "`__builtin_popcount` expects an `unsigned int`, but the provided parameter is of type `uint32_t` which is not the same as `unsigned int` on this machine.");
          return __builtin_popcount(n);
       }
+      int popcount(uint64_t n) noexcept
+      {
+         static_assert(sizeof(uint64_t) == sizeof(unsigned long long), "`__builtin_popcountll` expects an `unsigned long long`, which has a different size than `uint64_t` on this machine.");
+         return __builtin_popcountll(n);
+      }
    #else
       int popcount(uint32_t n) noexcept
       {
@@ -27,6 +32,12 @@ namespace panda
           n = (n & 0x33333333) + ((n >> 2) & 0x33333333);
           return (((n + (n >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
       }
+      int popcount(uint64_t n) noexcept
+      {
+          n = n - ((n >> 1) & 0x5555555555555555);
+          n = (n & 0x3333333333333333) + ((n >> 2) & 0x3333333333333333);
+          return static_cast<int>((((n + (n >> 4)) & 0x0F0F0F0F0F0F0F0F) * 0x0101010101010101) >> 56);
+      }
    #endif
 }
 
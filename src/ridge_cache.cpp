@@ -0,0 +1,246 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#define COMPILE_TEMPLATE_RIDGE_CACHE
+#include "ridge_cache.h"
+#undef COMPILE_TEMPLATE_RIDGE_CACHE
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   using Order = std::vector<std::size_t>;
+   /// Order of all but the last column that only depends on the set of rows, up to the order among columns it cannot distinguish.
+   template <typename Integer>
+   Order canonicalOrder(const Matrix<Integer>&);
+   /// Ranks of the given values, equal values get equal ranks.
+   template <typename Value>
+   std::vector<std::size_t> ranks(const std::vector<Value>&);
+   /// Rows with their columns in the given order, the rows sorted.
+   template <typename Integer>
+   Matrix<Integer> permuted(const Matrix<Integer>&, const Order&);
+   /// Inverse of permuted for unsorted rows: column order[j] of the result is column j of the input.
+   template <typename Integer>
+   Matrix<Integer> restored(const Matrix<Integer>&, const Order&);
+   /// Bytes occupied by the integers of the rows.
+   template <typename Integer>
+   std::size_t bytes(const Matrix<Integer>&) noexcept;
+}
+
+template <typename Integer>
+panda::RidgeCache<Integer>::RidgeCache(const std::size_t limit_)
+:
+   mutex(),
+   limit(limit_),
+   entries(),
+   uses(),
+   size(0),
+   lookup_count(0),
+   hit_count(0),
+   eviction_count(0)
+{
+}
+
+template <typename Integer>
+Inequalities<Integer> panda::RidgeCache<Integer>::ridges(const Vertices<Integer>& vertices, const Computation& computation)
+{
+   assert( !vertices.empty() );
+   const auto order = canonicalOrder(vertices);
+   auto key = permuted(vertices, order);
+   {
+      const std::lock_guard<std::mutex> lock(mutex);
+      ++lookup_count;
+      const auto it = entries.find(key);
+      if ( it != entries.end() )
+      {
+         ++hit_count;
+         uses.splice(uses.begin(), uses, it->second.use);
+         return restored(it->second.ridges, order);
+      }
+   }
+   // equal keys mean equal vertex sets after permutation, the ridges are then permuted alike.
+   auto ridges = computation(vertices);
+   auto canonical_ridges = permuted(ridges, order);
+   const auto entry_size = bytes(key) + bytes(canonical_ridges);
+   const std::lock_guard<std::mutex> lock(mutex);
+   if ( limit > 0 && entry_size > limit )
+   {
+      return ridges;
+   }
+   // another thread may have stored the same key meanwhile.
+   const auto inserted = entries.emplace(std::move(key), Entry{std::move(canonical_ridges), entry_size, uses.end()});
+   if ( !inserted.second )
+   {
+      return ridges;
+   }
+   uses.push_front(&inserted.first->first);
+   inserted.first->second.use = uses.begin();
+   size += entry_size;
+   while ( limit > 0 && size > limit )
+   {
+      const auto oldest = entries.find(*uses.back());
+      assert( oldest != entries.end() );
+      size -= oldest->second.bytes;
+      uses.pop_back();
+      entries.erase(oldest);
+      ++eviction_count;
+   }
+   return ridges;
+}
+
+template <typename Integer>
+std::size_t panda::RidgeCache<Integer>::lookups() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   return lookup_count;
+}
+
+template <typename Integer>
+std::size_t panda::RidgeCache<Integer>::hits() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   return hit_count;
+}
+
+template <typename Integer>
+std::size_t panda::RidgeCache<Integer>::evictions() const
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   return eviction_count;
+}
+
+namespace
+{
+   template <typename Integer>
+   Order canonicalOrder(const Matrix<Integer>& rows)
+   {
+      const auto columns = rows.front().size() - 1;
+      // colour refinement: columns are told apart by the colours of the rows their entries belong to and vice versa.
+      std::vector<std::size_t> column_colours(columns, 0);
+      std::size_t colour_count = 1;
+      while ( colour_count < columns )
+      {
+         std::vector<std::vector<std::pair<std::size_t, Integer>>> row_signatures(rows.size());
+         for ( std::size_t i = 0; i < rows.size(); ++i )
+         {
+            auto& signature = row_signatures[i];
+            for ( std::size_t j = 0; j < columns; ++j )
+            {
+               signature.emplace_back(column_colours[j], rows[i][j]);
+            }
+            std::sort(signature.begin(), signature.end());
+            signature.emplace_back(0, rows[i].back());
+         }
+         const auto row_colours = ranks(row_signatures);
+         std::vector<std::pair<std::size_t, std::vector<std::pair<std::size_t, Integer>>>> column_signatures(columns);
+         for ( std::size_t j = 0; j < columns; ++j )
+         {
+            auto& signature = column_signatures[j];
+            signature.first = column_colours[j];
+            for ( std::size_t i = 0; i < rows.size(); ++i )
+            {
+               signature.second.emplace_back(row_colours[i], rows[i][j]);
+            }
+            std::sort(signature.second.begin(), signature.second.end());
+         }
+         column_colours = ranks(column_signatures);
+         const auto new_colour_count = 1 + *std::max_element(column_colours.cbegin(), column_colours.cend());
+         if ( new_colour_count == colour_count )
+         {
+            break;
+         }
+         colour_count = new_colour_count;
+      }
+      Order order(columns);
+      for ( std::size_t j = 0; j < columns; ++j )
+      {
+         order[j] = j;
+      }
+      std::stable_sort(order.begin(), order.end(), [&column_colours](const std::size_t a, const std::size_t b)
+      {
+         return column_colours[a] < column_colours[b];
+      });
+      return order;
+   }
+
+   template <typename Value>
+   std::vector<std::size_t> ranks(const std::vector<Value>& values)
+   {
+      std::vector<const Value*> sorted;
+      sorted.reserve(values.size());
+      for ( const auto& value : values )
+      {
+         sorted.push_back(&value);
+      }
+      std::sort(sorted.begin(), sorted.end(), [](const Value* a, const Value* b)
+      {
+         return *a < *b;
+      });
+      sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const Value* a, const Value* b)
+      {
+         return *a == *b;
+      }), sorted.end());
+      std::vector<std::size_t> result;
+      result.reserve(values.size());
+      for ( const auto& value : values )
+      {
+         const auto it = std::lower_bound(sorted.cbegin(), sorted.cend(), &value, [](const Value* a, const Value* b)
+         {
+            return *a < *b;
+         });
+         result.push_back(static_cast<std::size_t>(it - sorted.cbegin()));
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   Matrix<Integer> permuted(const Matrix<Integer>& rows, const Order& order)
+   {
+      Matrix<Integer> result;
+      result.reserve(rows.size());
+      for ( const auto& row : rows )
+      {
+         Row<Integer> new_row;
+         new_row.reserve(row.size());
+         for ( const auto j : order )
+         {
+            new_row.push_back(row[j]);
+         }
+         new_row.push_back(row.back());
+         result.push_back(std::move(new_row));
+      }
+      std::sort(result.begin(), result.end());
+      return result;
+   }
+
+   template <typename Integer>
+   Matrix<Integer> restored(const Matrix<Integer>& rows, const Order& order)
+   {
+      Matrix<Integer> result;
+      result.reserve(rows.size());
+      for ( const auto& row : rows )
+      {
+         Row<Integer> new_row(row.size());
+         for ( std::size_t j = 0; j < order.size(); ++j )
+         {
+            new_row[order[j]] = row[j];
+         }
+         new_row.back() = row.back();
+         result.push_back(std::move(new_row));
+      }
+      return result;
+   }
+
+   template <typename Integer>
+   std::size_t bytes(const Matrix<Integer>& rows) noexcept
+   {
+      return rows.empty() ? 0 : rows.size() * rows.front().size() * sizeof(Integer);
+   }
+}
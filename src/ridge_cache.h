@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include "matrix.h"
+#include "row.h"
+
+namespace panda
+{
+   /// Cache of ridge computations of adjacency decomposition. Facets whose incident vertices are equal
+   /// up to a permutation of the coordinates have equally permuted ridges, so they are computed only once.
+   /// The key is the vertex set with its columns in an order derived from the vertices alone, the last column stays in place.
+   /// The entries are limited in size: like the memory limit of Fourier-Motzkin elimination, the size counts the integers
+   /// of the vertices and ridges only. Beyond it, the least recently used entries are evicted.
+   template <typename Integer>
+   class RidgeCache
+   {
+      public:
+         /// Function computing the ridges of the polytope spanned by the given vertices.
+         using Computation = std::function<Inequalities<Integer>(const Vertices<Integer>&)>;
+         /// Constructor of an empty cache whose entries may occupy the given number of bytes. Zero means no limit.
+         explicit RidgeCache(const std::size_t);
+         /// Returns the ridges of the polytope spanned by the vertices, mapped over from a previous computation if possible.
+         Inequalities<Integer> ridges(const Vertices<Integer>&, const Computation&);
+         /// Number of calls of ridges.
+         std::size_t lookups() const;
+         /// Number of calls of ridges answered from the cache.
+         std::size_t hits() const;
+         /// Number of entries evicted to stay within the size limit.
+         std::size_t evictions() const;
+         /// Copy construction is not allowed.
+         RidgeCache(const RidgeCache&) = delete;
+         /// Copy assignment is not allowed.
+         RidgeCache& operator=(const RidgeCache&) = delete;
+      private:
+         /// Stored ridges with their size and position in the order of use.
+         struct Entry
+         {
+            Inequalities<Integer> ridges;
+            std::size_t bytes;
+            typename std::list<const Vertices<Integer>*>::iterator use;
+         };
+      private:
+         mutable std::mutex mutex;
+         const std::size_t limit;
+         std::map<Vertices<Integer>, Entry> entries;
+         std::list<const Vertices<Integer>*> uses; // keys of the entries, most recently used first.
+         std::size_t size;
+         std::size_t lookup_count;
+         std::size_t hit_count;
+         std::size_t eviction_count;
+   };
+}
+
+#include "ridge_cache.eti"
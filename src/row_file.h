@@ -0,0 +1,57 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dense_matrix.h"
+
+namespace panda
+{
+   /// Rows of a fixed number of columns kept in an anonymous temporary file instead of memory.
+   /// Rows are appended sequentially and read back in blocks of a fixed number of rows,
+   /// so that only a few blocks of a system exceeding the memory need to be held at a time.
+   /// The file is removed when the object is destroyed.
+   template <typename Integer>
+   class RowFile
+   {
+      public:
+         /// Constructor taking the number of columns and the number of rows per block.
+         RowFile(const std::size_t, const std::size_t);
+         /// Returns the number of rows.
+         std::size_t rows() const noexcept;
+         /// Returns the number of columns.
+         std::size_t columns() const noexcept;
+         /// Returns the number of rows per block.
+         std::size_t blockSize() const noexcept;
+         /// Returns the number of blocks. Only the last block may have less rows than the block size.
+         std::size_t blocks() const noexcept;
+         /// Appends a row given by a pointer to its first entry.
+         void append(const Integer*);
+         /// Reads a block. Block b holds the rows [b * blockSize(), (b + 1) * blockSize()).
+         DenseMatrix<Integer> block(const std::size_t);
+      private:
+         /// Writes the buffered rows to the file as a new block.
+         void writeBlock();
+      private:
+         std::size_t column_count;
+         std::size_t block_size;
+         std::size_t row_count;
+         /// Rows of the last block, which are not yet written.
+         DenseMatrix<Integer> pending;
+         std::unique_ptr<std::FILE, int(*)(std::FILE*)> file;
+         /// Position and length in bytes of each written block.
+         std::vector<std::pair<std::fpos_t, std::size_t>> positions;
+   };
+}
+
+#include "row_file.tpp"
+
@@ -0,0 +1,110 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "fourier_motzkin_checkpoint.h"
+
+template <typename Integer>
+panda::RowFile<Integer>::RowFile(const std::size_t columns_, const std::size_t block_size_)
+:
+   column_count(columns_),
+   block_size(block_size_),
+   row_count(0),
+   pending(0, columns_),
+   file(std::tmpfile(), &std::fclose),
+   positions()
+{
+   assert( block_size > 0 );
+   if ( !file )
+   {
+      throw std::runtime_error("Cannot create a temporary file for rows exceeding the memory limit.");
+   }
+}
+
+template <typename Integer>
+std::size_t panda::RowFile<Integer>::rows() const noexcept
+{
+   return row_count;
+}
+
+template <typename Integer>
+std::size_t panda::RowFile<Integer>::columns() const noexcept
+{
+   return column_count;
+}
+
+template <typename Integer>
+std::size_t panda::RowFile<Integer>::blockSize() const noexcept
+{
+   return block_size;
+}
+
+template <typename Integer>
+std::size_t panda::RowFile<Integer>::blocks() const noexcept
+{
+   return positions.size() + (pending.empty() ? 0 : 1);
+}
+
+template <typename Integer>
+void panda::RowFile<Integer>::append(const Integer* row)
+{
+   const auto r = pending.rows();
+   pending.resizeRows(r + 1);
+   std::copy(row, row + column_count, pending[r]);
+   ++row_count;
+   if ( pending.rows() == block_size )
+   {
+      writeBlock();
+   }
+}
+
+template <typename Integer>
+panda::DenseMatrix<Integer> panda::RowFile<Integer>::block(const std::size_t b)
+{
+   assert( b < blocks() );
+   if ( b == positions.size() )
+   {
+      return pending;
+   }
+   std::string bytes(positions[b].second, '\0');
+   if ( std::fsetpos(file.get(), &positions[b].first) != 0 || std::fread(&bytes[0], 1, bytes.size(), file.get()) != bytes.size() )
+   {
+      throw std::runtime_error("Cannot read rows from a temporary file.");
+   }
+   std::istringstream stream(bytes);
+   // written blocks are always full.
+   DenseMatrix<Integer> result(block_size, column_count);
+   for ( std::size_t j = 0; j < result.rows(); ++j )
+   {
+      std::for_each(result[j], result[j] + column_count, [&stream](Integer& entry) { readBinary(stream, entry); });
+   }
+   return result;
+}
+
+template <typename Integer>
+void panda::RowFile<Integer>::writeBlock()
+{
+   std::ostringstream stream;
+   for ( std::size_t j = 0; j < pending.rows(); ++j )
+   {
+      std::for_each(pending[j], pending[j] + column_count, [&stream](const Integer& entry) { writeBinary(stream, entry); });
+   }
+   const auto bytes = stream.str();
+   std::fpos_t position;
+   // reading moves the position of the file, blocks are always written at its end.
+   if ( std::fseek(file.get(), 0, SEEK_END) != 0 || std::fgetpos(file.get(), &position) != 0 || std::fwrite(bytes.data(), 1, bytes.size(), file.get()) != bytes.size() )
+   {
+      throw std::runtime_error("Cannot write rows to a temporary file.");
+   }
+   positions.emplace_back(position, bytes.size());
+   pending.resizeRows(0);
+}
+
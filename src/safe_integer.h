@@ -8,6 +8,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <iosfwd>
 
 namespace panda
 {
@@ -15,6 +16,10 @@ namespace panda
 
    /// Absolute value.
    inline SafeInteger abs(SafeInteger);
+   /// Writes the integer to a binary stream.
+   inline void writeBinary(std::ostream&, const SafeInteger&);
+   /// Reads an integer written by writeBinary.
+   inline void readBinary(std::istream&, SafeInteger&);
 
    class SafeInteger
    {
@@ -106,6 +111,8 @@ namespace panda
          inline SafeInteger operator-() const;
          /// Absolute value.
          friend SafeInteger abs(SafeInteger);
+         friend void writeBinary(std::ostream&, const SafeInteger&);
+         friend void readBinary(std::istream&, SafeInteger&);
       public:
          /// Underlying data type.
          using DataType = int64_t;
@@ -4,7 +4,9 @@
 // License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
 //-------------------------------------------------------------------------------//
 
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 
@@ -40,6 +42,16 @@ panda::SafeInteger panda::abs(SafeInteger n)
    return (n < 0) ? -n : n;
 }
 
+void panda::writeBinary(std::ostream& stream, const SafeInteger& n)
+{
+   stream.write(reinterpret_cast<const char*>(&n.data), sizeof(n.data));
+}
+
+void panda::readBinary(std::istream& stream, SafeInteger& n)
+{
+   stream.read(reinterpret_cast<char*>(&n.data), sizeof(n.data));
+}
+
 namespace panda
 {
    namespace
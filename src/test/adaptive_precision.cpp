@@ -0,0 +1,113 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "adaptive_precision.h"
+
+#include <cstddef>
+#include <functional>
+#include <set>
+
+using namespace panda;
+
+namespace
+{
+   Vertices<BigInteger> cube(const BigInteger&);
+   std::set<Facet<BigInteger>> expected(const Vertices<BigInteger>&, const Facet<BigInteger>&);
+   void checked();
+   void promoted();
+   void unfitting();
+}
+
+int main()
+try
+{
+   checked();
+   promoted();
+   unfitting();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   const auto sequential = [](const std::size_t size, const std::function<void(std::size_t)>& function)
+   {
+      for ( std::size_t k = 0; k < size; ++k )
+      {
+         function(k);
+      }
+   };
+
+   const Facet<BigInteger> facet{BigInteger(-1), BigInteger(0), BigInteger(0), BigInteger(0), BigInteger(0)};
+
+   Vertices<BigInteger> cube(const BigInteger& length)
+   {
+      Vertices<BigInteger> vertices;
+      for ( int k = 0; k < 16; ++k )
+      {
+         Vertex<BigInteger> vertex;
+         for ( int i = 0; i < 4; ++i )
+         {
+            vertex.push_back(((k >> i) & 1) ? length : BigInteger(0));
+         }
+         vertex.push_back(BigInteger(1));
+         vertices.push_back(vertex);
+      }
+      return vertices;
+   }
+
+   std::set<Facet<BigInteger>> expected(const Vertices<BigInteger>& vertices, const Facet<BigInteger>& job)
+   {
+      const auto neighbours = algorithm::rotation<BigInteger>(vertices, job, Maps(), tag::facet{}, AdjacencyDecompositionSettings(), sequential, nullptr);
+      return std::set<Facet<BigInteger>>(neighbours.cbegin(), neighbours.cend());
+   }
+
+   void checked()
+   {
+      const auto vertices = cube(BigInteger(1));
+      AdaptivePrecision adaptive(vertices, 0);
+      const auto neighbours = adaptive.rotation(facet, Maps(), tag::facet{}, AdjacencyDecompositionSettings(), sequential, nullptr);
+      ASSERT((std::set<Facet<BigInteger>>(neighbours.cbegin(), neighbours.cend()) == expected(vertices, facet)), "The neighbours must not depend on the integer type.");
+      ASSERT(adaptive.jobs() == 1, "One job was computed.");
+      ASSERT(adaptive.promotions() == 0, "Small numbers fit into the checked integer type.");
+   }
+
+   void promoted()
+   {
+      // the coordinates fit into 64bit, but their products do not.
+      BigInteger length(1);
+      for ( int k = 0; k < 40; ++k )
+      {
+         length *= BigInteger(2);
+      }
+      const auto vertices = cube(length);
+      AdaptivePrecision adaptive(vertices, 0);
+      const auto neighbours = adaptive.rotation(facet, Maps(), tag::facet{}, AdjacencyDecompositionSettings(), sequential, nullptr);
+      ASSERT((std::set<Facet<BigInteger>>(neighbours.cbegin(), neighbours.cend()) == expected(vertices, facet)), "The neighbours must not depend on the integer type.");
+      ASSERT(adaptive.jobs() == 1, "One job was computed.");
+      ASSERT(adaptive.promotions() == 1, "The job overflows in the checked integer type.");
+   }
+
+   void unfitting()
+   {
+      // the coordinates themselves do not fit into 64bit.
+      BigInteger length(1);
+      for ( int k = 0; k < 70; ++k )
+      {
+         length *= BigInteger(2);
+      }
+      const auto vertices = cube(length);
+      AdaptivePrecision adaptive(vertices, 0);
+      const auto neighbours = adaptive.rotation(facet, Maps(), tag::facet{}, AdjacencyDecompositionSettings(), sequential, nullptr);
+      ASSERT((std::set<Facet<BigInteger>>(neighbours.cbegin(), neighbours.cend()) == expected(vertices, facet)), "The neighbours must not depend on the integer type.");
+      ASSERT(adaptive.promotions() == 1, "Input that does not fit is always computed with arbitrary precision.");
+   }
+}
@@ -16,6 +16,8 @@ namespace
 {
    void facet_class();
    void representative();
+   void representativeCheck();
+   void parallelClasses();
 }
 
 int main()
@@ -23,6 +25,8 @@ try
 {
    facet_class();
    representative();
+   representativeCheck();
+   parallelClasses();
 }
 catch ( const TestingGearException& e )
 {
@@ -51,5 +55,50 @@ namespace
       const auto rep = algorithm::classRepresentative(facet, {xy, x}, tag::facet{});
       ASSERT((rep == Facet<int>{1, 0, 0, -1}), "");
    }
-}
 
+   void representativeCheck()
+   {
+      Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      Map x{{std::make_pair(0u, -1), std::make_pair(3u, 1)},{std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      for ( const auto& facet : algorithm::getClass(Facet<int>{1, 0, 0, -1}, {xy, x}, tag::facet{}) )
+      {
+         const auto is_representative = (facet == algorithm::classRepresentative(facet, {xy, x}, tag::facet{}));
+         ASSERT(algorithm::isClassRepresentative(facet, {xy, x}, tag::facet{}) == is_representative, "");
+      }
+   }
+
+   void parallelClasses()
+   {
+      Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      Map x{{std::make_pair(0u, -1), std::make_pair(3u, 1)},{std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      // all small facets, so most classes are complete, but some are not.
+      std::set<Facet<int>> facets;
+      for ( int a = -2; a <= 2; ++a )
+      {
+         for ( int b = -2; b <= 2; ++b )
+         {
+            for ( int c = -1; c <= 1; ++c )
+            {
+               facets.insert({a, b, c, -1});
+            }
+         }
+      }
+      // sequential reference: take the first remaining row and erase its class.
+      Matrix<int> expected;
+      auto remaining = facets;
+      while ( !remaining.empty() )
+      {
+         const auto row_class = algorithm::getClass(*remaining.begin(), {xy, x}, tag::facet{});
+         expected.push_back(*row_class.crbegin());
+         for ( const auto& row : row_class )
+         {
+            remaining.erase(row);
+         }
+      }
+      ASSERT(algorithm::classes(facets, {xy, x}, tag::facet{}) == expected, "Classes must be taken in order of their first row.");
+      for ( const std::size_t thread_count : {2u, 3u, 8u} )
+      {
+         ASSERT(algorithm::classes(facets, {xy, x}, tag::facet{}, thread_count) == expected, "Parallel classes must not depend on the number of threads.");
+      }
+   }
+}
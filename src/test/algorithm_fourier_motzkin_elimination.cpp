@@ -10,7 +10,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <random>
+#include <stdexcept>
+
+#include "algorithm_classes.h"
+#include "algorithm_row_operations.h"
 
 using namespace panda;
 
@@ -18,6 +23,18 @@ namespace
 {
    void facetsConvexOnly();
    void vertices();
+   /// Some 0/1 points in dimension 7, many of them on common facets.
+   Vertices<int> degeneratePoints();
+   void multithreaded();
+   void adjacencyTests();
+   void pairFilters();
+   void adaptiveOrders();
+   void portfolio();
+   void checkpoints();
+   void outOfCore();
+   void streamedRepresentatives();
+   void incremental();
+   void heuristic();
 }
 
 int main()
@@ -25,6 +42,16 @@ try
 {
    facetsConvexOnly();
    vertices();
+   multithreaded();
+   adjacencyTests();
+   pairFilters();
+   adaptiveOrders();
+   portfolio();
+   checkpoints();
+   outOfCore();
+   streamedRepresentatives();
+   incremental();
+   heuristic();
 }
 catch ( const TestingGearException& e )
 {
@@ -164,5 +191,223 @@ namespace
          ASSERT(vs == correct, "Data mismatch.");
       }
    }
-}
 
+   Vertices<int> degeneratePoints()
+   {
+      // all 0/1 points with at most two ones in dimension 7 plus some of the remaining ones
+      Vertices<int> points;
+      for ( int mask = 0; mask < (1 << 7); ++mask )
+      {
+         int ones = 0;
+         for ( int k = 0; k < 7; ++k )
+         {
+            ones += (mask >> k) & 1;
+         }
+         if ( ones <= 2 || mask % 5 == 0 )
+         {
+            Vertex<int> point;
+            for ( int k = 0; k < 7; ++k )
+            {
+               point.push_back((mask >> k) & 1);
+            }
+            point.push_back(1);
+            points.push_back(point);
+         }
+      }
+      return points;
+   }
+
+   void multithreaded()
+   {
+      const auto points = degeneratePoints();
+      const auto sequential = algorithm::fourierMotzkinElimination(points);
+      for ( const std::size_t thread_count : {2u, 3u, 8u} )
+      {
+         FourierMotzkinSettings settings;
+         settings.thread_count = thread_count;
+         const auto parallel = algorithm::fourierMotzkinElimination(points, settings);
+         ASSERT(parallel == sequential, "Multithreaded elimination must produce the same rows in the same order.");
+      }
+   }
+
+   void adjacencyTests()
+   {
+      const auto points = degeneratePoints();
+      const auto scan = algorithm::fourierMotzkinElimination(points);
+      FourierMotzkinSettings settings;
+      settings.adjacency_test = AdjacencyTest::Transposed;
+      ASSERT(algorithm::fourierMotzkinElimination(points, settings) == scan, "Adjacency tests must agree.");
+      settings.thread_count = 3;
+      ASSERT(algorithm::fourierMotzkinElimination(points, settings) == scan, "Adjacency tests must agree.");
+      settings.thread_count = 1;
+      settings.adjacency_test = AdjacencyTest::Algebraic;
+      ASSERT(algorithm::fourierMotzkinElimination(points, settings) == scan, "Adjacency tests must agree.");
+      settings.adjacency_test = AdjacencyTest::Automatic;
+      ASSERT(algorithm::fourierMotzkinElimination(points, settings) == scan, "Adjacency tests must agree.");
+   }
+
+   void pairFilters()
+   {
+      const auto points = degeneratePoints();
+      FourierMotzkinSettings settings;
+      settings.pair_filter = PairFilter::List;
+      const auto list = algorithm::fourierMotzkinElimination(points, settings);
+      settings.pair_filter = PairFilter::SubsetIndex;
+      ASSERT(algorithm::fourierMotzkinElimination(points, settings) == list, "Pair filters must agree.");
+      settings.thread_count = 3;
+      ASSERT(algorithm::fourierMotzkinElimination(points, settings) == list, "Pair filters must agree.");
+   }
+
+   void adaptiveOrders()
+   {
+      const auto points = degeneratePoints();
+      auto fixed = algorithm::fourierMotzkinElimination(points);
+      std::sort(fixed.begin(), fixed.end());
+      for ( const auto order : {InputOrder::MinCutoff, InputOrder::MaxIntersection, InputOrder::PredictedMin} )
+      {
+         FourierMotzkinSettings settings;
+         settings.insertion_order = order;
+         auto adaptive = algorithm::fourierMotzkinElimination(points, settings);
+         std::sort(adaptive.begin(), adaptive.end());
+         ASSERT(adaptive == fixed, "Insertion order may not change the facets.");
+      }
+   }
+
+   void portfolio()
+   {
+      const auto points = degeneratePoints();
+      auto fixed = algorithm::fourierMotzkinElimination(points);
+      std::sort(fixed.begin(), fixed.end());
+      FourierMotzkinSettings settings;
+      settings.insertion_order = InputOrder::Portfolio;
+      auto winner = algorithm::fourierMotzkinElimination(points, settings);
+      std::sort(winner.begin(), winner.end());
+      ASSERT(winner == fixed, "The portfolio must return the facets of any single order.");
+      for ( const std::size_t thread_count : {2u, 5u, 24u} )
+      {
+         settings.thread_count = thread_count;
+         settings.memory_limit = 1;
+         winner = algorithm::fourierMotzkinElimination(points, settings);
+         std::sort(winner.begin(), winner.end());
+         ASSERT(winner == fixed, "The portfolio must share threads and memory among its runs.");
+      }
+      settings.checkpoint_file = "algorithm_fourier_motzkin_elimination.portfolio";
+      ASSERT_EXCEPTION(algorithm::fourierMotzkinElimination(points, settings), std::invalid_argument, "The portfolio does not support checkpoints.");
+   }
+
+   void checkpoints()
+   {
+      const auto points = degeneratePoints();
+      const std::string filename = "algorithm_fourier_motzkin_elimination.checkpoint";
+      FourierMotzkinSettings settings;
+      settings.checkpoint_file = filename;
+      settings.checkpoint_interval = std::chrono::seconds(0);
+      const auto original = algorithm::fourierMotzkinElimination(points, settings);
+      FourierMotzkinSettings resumed;
+      resumed.resume_file = filename;
+      ASSERT(algorithm::fourierMotzkinElimination(points, resumed) == original, "A resumed run must produce the same rows in the same order.");
+      resumed.insertion_order = InputOrder::PredictedMin;
+      ASSERT_EXCEPTION(algorithm::fourierMotzkinElimination(points, resumed), std::invalid_argument, "Checkpoints of other settings must be rejected.");
+      std::remove(filename.c_str());
+      ASSERT_EXCEPTION(algorithm::fourierMotzkinElimination(points, settings = resumed), std::invalid_argument, "Missing checkpoints must be reported.");
+   }
+
+   void outOfCore()
+   {
+      const auto points = degeneratePoints();
+      auto in_memory = algorithm::fourierMotzkinElimination(points);
+      std::sort(in_memory.begin(), in_memory.end());
+      // the smallest limit keeps every system in files, the others move systems back and forth.
+      for ( const std::size_t limit : {1u, 1000u, 4000u} )
+      {
+         for ( const std::size_t thread_count : {1u, 3u} )
+         {
+            FourierMotzkinSettings settings;
+            settings.memory_limit = limit;
+            settings.thread_count = thread_count;
+            auto out_of_core = algorithm::fourierMotzkinElimination(points, settings);
+            std::sort(out_of_core.begin(), out_of_core.end());
+            ASSERT(out_of_core == in_memory, "Out-of-core elimination must produce the same facets.");
+         }
+      }
+      FourierMotzkinSettings settings;
+      settings.memory_limit = 1;
+      settings.insertion_order = InputOrder::PredictedMin;
+      auto adaptive = algorithm::fourierMotzkinElimination(points, settings);
+      std::sort(adaptive.begin(), adaptive.end());
+      ASSERT(adaptive == in_memory, "Adaptive orders must work on systems in files.");
+   }
+
+   void streamedRepresentatives()
+   {
+      const Vertices<int> cube{{0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}, {1, 1, 0, 1}, {0, 0, 1, 1}, {1, 0, 1, 1}, {0, 1, 1, 1}, {1, 1, 1, 1}};
+      const Map xy{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      const Map yz{{std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(3u, 1)}};
+      const Map x{{std::make_pair(0u, -1), std::make_pair(3u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}};
+      for ( const auto& maps : {Maps{xy, yz, x}, Maps{xy, yz}, Maps{x}} )
+      {
+         auto full = algorithm::classes(algorithm::fourierMotzkinElimination(cube), maps, tag::facet{});
+         std::sort(full.begin(), full.end());
+         FourierMotzkinSettings settings;
+         settings.thread_count = 3;
+         Facets<int> streamed;
+         algorithm::fourierMotzkinElimination<int>(cube, settings, maps, tag::facet{}, [&streamed](const Facets<int>& rows)
+         {
+            ASSERT(!rows.empty(), "Empty batches must not be passed.");
+            streamed.insert(streamed.end(), rows.cbegin(), rows.cend());
+         });
+         std::sort(streamed.begin(), streamed.end());
+         ASSERT(streamed == full, "Streamed representatives must match the representatives of classes().");
+      }
+   }
+
+   void incremental()
+   {
+      auto points = degeneratePoints();
+      auto full = algorithm::fourierMotzkinElimination(points);
+      std::sort(full.begin(), full.end());
+      // the first points already span the space, the last ones are added to their convex hull.
+      const Vertices<int> previous_points(points.begin(), points.end() - 4);
+      const auto previous = algorithm::fourierMotzkinElimination(previous_points);
+      std::reverse(points.begin(), points.end());
+      auto extended = algorithm::fourierMotzkinEliminationIncremental(points, previous, FourierMotzkinSettings());
+      std::sort(extended.begin(), extended.end());
+      ASSERT(extended == full, "Incremental elimination must yield the facets of all points.");
+      FourierMotzkinSettings settings;
+      settings.insertion_order = InputOrder::Portfolio;
+      auto portfolio = algorithm::fourierMotzkinEliminationIncremental(points, previous, settings);
+      std::sort(portfolio.begin(), portfolio.end());
+      ASSERT(portfolio == full, "The portfolio order must apply to the new vertices.");
+      settings = FourierMotzkinSettings();
+      settings.memory_limit = 1;
+      auto out_of_core = algorithm::fourierMotzkinEliminationIncremental(points, previous, settings);
+      std::sort(out_of_core.begin(), out_of_core.end());
+      ASSERT(out_of_core == full, "The memory limit must apply to the new vertices.");
+      const std::string filename = "algorithm_fourier_motzkin_elimination.incremental";
+      settings = FourierMotzkinSettings();
+      settings.checkpoint_file = filename;
+      settings.checkpoint_interval = std::chrono::seconds(0);
+      const auto original = algorithm::fourierMotzkinEliminationIncremental(points, previous, settings);
+      FourierMotzkinSettings resumed;
+      resumed.resume_file = filename;
+      ASSERT(algorithm::fourierMotzkinEliminationIncremental(points, previous, resumed) == original, "An incremental run must resume from its checkpoint.");
+      std::remove(filename.c_str());
+      ASSERT_EXCEPTION(algorithm::fourierMotzkinEliminationIncremental(points, Facets<int>(), FourierMotzkinSettings()), std::invalid_argument, "Facets of a previous result are required.");
+      // the sum of two facets is valid for the previous points, but tight on fewer than d - 1 affinely independent ones.
+      auto with_sum = previous;
+      with_sum.push_back(previous[0] + previous[1]);
+      ASSERT_EXCEPTION(algorithm::fourierMotzkinEliminationIncremental(points, with_sum, FourierMotzkinSettings()), std::invalid_argument, "Inequalities that are not facets of the previous polytope must be rejected.");
+   }
+
+   void heuristic()
+   {
+      const auto points = degeneratePoints();
+      const auto facets = algorithm::fourierMotzkinElimination(points);
+      const auto some = algorithm::fourierMotzkinEliminationHeuristic(points);
+      ASSERT(!some.empty(), "The heuristic must find a facet.");
+      for ( const auto& row : some )
+      {
+         ASSERT(std::find(facets.cbegin(), facets.cend(), row) != facets.cend(), "The heuristic may only output facets.");
+      }
+   }
+}
@@ -8,8 +8,11 @@
 
 #include "algorithm_matrix_operations.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "algorithm_row_operations.h"
+
 using namespace panda;
 
 namespace
@@ -18,6 +21,8 @@ namespace
    void mapping();
    void dimension();
    void gaussian_elimination();
+   void gaussian_elimination_threads();
+   void large_minors();
    void transposition();
 }
 
@@ -28,6 +33,8 @@ try
    mapping();
    dimension();
    gaussian_elimination();
+   gaussian_elimination_threads();
+   large_minors();
    transposition();
 }
 catch ( const TestingGearException& e )
@@ -97,6 +104,55 @@ namespace
       ASSERT((r == Matrix<int>{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}), "Data mismatch");
    }
 
+   void gaussian_elimination_threads()
+   {
+      Matrix<int> m{{1, 1, 0, 0}, {1, 0, 1, 0}, {2, 1, 1, 0}, {0, 1, 1, 1}, {3, 0, 2, 1}, {1, 2, 3, 4}};
+      algorithm::appendNegativeIdentityMatrix(m);
+      DenseMatrix<int> sequential(m);
+      const auto indices = algorithm::gaussianElimination(sequential);
+      ASSERT((indices.first == Indices{} && indices.second == Indices{0, 1, 3, 4}), "Pivot rows mismatch.");
+      // the columns are primitive with a positive leading entry.
+      for ( std::size_t col = 0; col < 4; ++col )
+      {
+         Row<int> column;
+         for ( std::size_t row = 0; row < sequential.rows(); ++row )
+         {
+            column.push_back(sequential[row][col]);
+         }
+         ASSERT(algorithm::gcd(column) == 1, "Columns must be primitive.");
+         ASSERT(*std::find_if(column.cbegin(), column.cend(), [](int a) { return a != 0; }) > 0, "Leading entries must be positive.");
+      }
+      DenseMatrix<int> parallel(m);
+      ASSERT(algorithm::gaussianElimination(parallel, 3) == indices, "Threads may not change the pivots.");
+      ASSERT(parallel.toMatrix() == sequential.toMatrix(), "Threads may not change the result.");
+   }
+
+   void large_minors()
+   {
+      // the minors of a scaled matrix carry powers of the scale, products of two of them exceed 2^31.
+      const int c = 1000;
+      ASSERT(algorithm::dimension(Matrix<int>{{c, 2 * c, 4 * c}, {c, 3 * c, 9 * c}, {c, 5 * c, 25 * c}}) == 3, "Data mismatch.");
+      ASSERT(algorithm::dimension(Matrix<int>{{c, 2 * c, 3 * c}, {4 * c, 5 * c, 6 * c}, {7 * c, 8 * c, 9 * c}}) == 2, "Data mismatch.");
+      ASSERT(algorithm::dimension(Matrix<int>{{c, 0, 0, c}, {c, c, 0, 0}, {0, c, c, 0}, {0, 0, c, c}}) == 3, "Data mismatch.");
+      const Matrix<int> o{{c, 2 * c, 4 * c}, {c, 3 * c, 9 * c}, {c, 5 * c, 25 * c}};
+      auto m = o;
+      algorithm::appendNegativeIdentityMatrix(m);
+      ASSERT_NOTHROW(algorithm::gaussianElimination(m), "Gaussian elimination may not throw.");
+      m.erase(m.begin(), m.begin() + 3);
+      for ( std::size_t i = 0; i < 3; ++i )
+      {
+         for ( std::size_t j = 0; j < 3; ++j )
+         {
+            long long product = 0;
+            for ( std::size_t k = 0; k < 3; ++k )
+            {
+               product += static_cast<long long>(o[i][k]) * m[k][j];
+            }
+            ASSERT((product != 0) == (i == j), "The result must be a scaled inverse.");
+         }
+      }
+   }
+
    void transposition()
    {
       Matrix<int> m{{1, 5}, {2, 6}, {3, 7}, {4, 8}};
@@ -0,0 +1,99 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "algorithm_modular_rank.h"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "algorithm_matrix_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void smallMatrices();
+   void randomMatrices();
+   void largeEntries();
+}
+
+int main()
+try
+{
+   smallMatrices();
+   randomMatrices();
+   largeEntries();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void smallMatrices()
+   {
+      using Result = std::pair<std::size_t, bool>;
+      ASSERT((algorithm::modularRank(Matrix<int>{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}) == Result(3, true)), "");
+      ASSERT((algorithm::modularRank(Matrix<int>{{1, 0, 0}, {0, 1, 0}, {0, 1, 0}}) == Result(2, true)), "");
+      ASSERT((algorithm::modularRank(Matrix<int>{{1, 0, 0}, {0, 1, 0}, {0, 1, 0}, {0, 1, 0}, {2, -1, 0}}) == Result(2, true)), "");
+      ASSERT((algorithm::modularRank(Matrix<int>{{1, 2, 3}, {0, 1, 0}}) == Result(2, true)), "");
+      ASSERT((algorithm::modularRank(Matrix<int>{{0, 0, 0}, {0, 1, 0}}) == Result(1, true)), "");
+      ASSERT((algorithm::modularRank(Matrix<int>{{0, 0, 0}, {0, 0, 0}}) == Result(0, true)), "");
+      ASSERT((algorithm::modularRank(Matrix<int>{{3, -6, 9}, {-2, 4, -6}, {1, 1, 1}, {4, -2, 8}}) == Result(2, true)), "");
+   }
+
+   void randomMatrices()
+   {
+      std::mt19937 generator(5);
+      std::uniform_int_distribution<int> entries(-3, 3);
+      for ( int trial = 0; trial < 200; ++trial )
+      {
+         const auto rows = 1 + trial % 9;
+         const auto columns = 1 + (trial / 9) % 7;
+         Matrix<int> matrix(static_cast<std::size_t>(rows), Row<int>(static_cast<std::size_t>(columns)));
+         for ( auto& row : matrix )
+         {
+            for ( auto& entry : row )
+            {
+               entry = entries(generator);
+            }
+         }
+         // dependent rows
+         if ( rows > 2 )
+         {
+            for ( std::size_t j = 0; j < matrix.front().size(); ++j )
+            {
+               matrix.back()[j] = 2 * matrix[0][j] - 3 * matrix[1][j];
+            }
+         }
+         const auto modular = algorithm::modularRank(matrix);
+         ASSERT(modular.second, "Small ranks must be confirmed.");
+         ASSERT(modular.first == algorithm::dimension(matrix), "Modular and exact rank differ.");
+      }
+   }
+
+   void largeEntries()
+   {
+      // entries beyond 64 bits, the third row is the sum of the first two.
+      BigInteger large(int64_t(1) << 62);
+      large *= BigInteger(int64_t(1) << 40);
+      const Matrix<BigInteger> matrix =
+      {
+         {large, -large, BigInteger(int64_t(3)), BigInteger(int64_t(1))},
+         {-large * BigInteger(int64_t(7)), BigInteger(int64_t(5)), large, BigInteger(int64_t(-2))},
+         {-large * BigInteger(int64_t(6)), BigInteger(int64_t(5)) - large, large + BigInteger(int64_t(3)), BigInteger(int64_t(-1))}
+      };
+      const auto modular = algorithm::modularRank(matrix);
+      ASSERT(modular.second && modular.first == 2, "Rank of large entries.");
+      ASSERT(algorithm::dimension(matrix) == 2, "Dimension of large entries.");
+   }
+}
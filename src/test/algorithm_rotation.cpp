@@ -0,0 +1,202 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "algorithm_rotation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+
+#include "ridge_cache.h"
+#include "work_stealing_pool.h"
+
+using namespace panda;
+
+namespace
+{
+   Vertices<int> cube();
+   Maps cubeMaps();
+   void neighbours();
+   void recursion();
+   void recursionStabilizer();
+   /// A pyramid whose base (on the facet x0 >= 0) holds random 0/1 points.
+   Vertices<int> pyramid();
+   void largeFacet();
+}
+
+int main()
+try
+{
+   neighbours();
+   recursion();
+   recursionStabilizer();
+   largeFacet();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   Vertices<int> cube()
+   {
+      Vertices<int> vertices;
+      for ( int k = 0; k < 16; ++k )
+      {
+         vertices.push_back({k & 1, (k >> 1) & 1, (k >> 2) & 1, (k >> 3) & 1, 1});
+      }
+      return vertices;
+   }
+
+   Maps cubeMaps()
+   {
+      // exchange of the second and third variable, which leaves the facet -x1 <= 0 unchanged, and a cyclic shift.
+      Map exchange{{std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(3u, 1)}, {std::make_pair(4u, 1)}};
+      Map shift{{std::make_pair(1u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(4u, 1)}};
+      return {exchange, shift};
+   }
+
+   void neighbours()
+   {
+      const auto neighbours = algorithm::rotation(cube(), Facet<int>{-1, 0, 0, 0, 0}, Maps(), tag::facet{});
+      ASSERT(neighbours.size() == 6, "A facet of the 4-cube has six neighbours.");
+      const auto classes = algorithm::rotation(cube(), Facet<int>{-1, 0, 0, 0, 0}, cubeMaps(), tag::facet{});
+      ASSERT(classes.size() == 2, "The neighbours of a facet of the 4-cube fall into two classes.");
+   }
+
+   void recursion()
+   {
+      const auto sequential = [](const std::size_t size, const std::function<void(std::size_t)>& function)
+      {
+         for ( std::size_t k = 0; k < size; ++k )
+         {
+            function(k);
+         }
+      };
+      const Facet<int> facet{-1, 0, 0, 0, 0};
+      const auto expected = algorithm::rotation(cube(), facet, cubeMaps(), tag::facet{});
+      for ( const std::size_t threshold : {1u, 2u, 4u} )
+      {
+         AdjacencyDecompositionSettings settings;
+         settings.recursion_threshold = threshold;
+         const auto classes = algorithm::rotation<int>(cube(), facet, cubeMaps(), tag::facet{}, settings, sequential, nullptr);
+         ASSERT((std::set<Facet<int>>(classes.cbegin(), classes.cend()) == std::set<Facet<int>>(expected.cbegin(), expected.cend())), "Recursive ridge computation must not change the neighbours.");
+         const auto all = algorithm::rotation<int>(cube(), facet, Maps(), tag::facet{}, settings, sequential, nullptr);
+         ASSERT(all.size() == 6, "Without maps, the recursion must find all ridges.");
+      }
+   }
+
+   void recursionStabilizer()
+   {
+      const auto sequential = [](const std::size_t size, const std::function<void(std::size_t)>& function)
+      {
+         for ( std::size_t k = 0; k < size; ++k )
+         {
+            function(k);
+         }
+      };
+      // all permutations of the last three variables leave the facet -x0 <= 0 unchanged.
+      Map exchange_first{{std::make_pair(1u, 1)}, {std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(3u, 1)}, {std::make_pair(4u, 1)}};
+      Map exchange_second{{std::make_pair(0u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(3u, 1)}, {std::make_pair(4u, 1)}};
+      Map exchange_third{{std::make_pair(0u, 1)}, {std::make_pair(1u, 1)}, {std::make_pair(3u, 1)}, {std::make_pair(2u, 1)}, {std::make_pair(4u, 1)}};
+      const Maps maps{exchange_first, exchange_second, exchange_third};
+      const Facet<int> facet{-1, 0, 0, 0, 0};
+      AdjacencyDecompositionSettings settings;
+      settings.recursion_threshold = 2;
+      RidgeCache<int> cache(0);
+      const auto classes = algorithm::rotation<int>(cube(), facet, maps, tag::facet{}, settings, sequential, &cache);
+      const auto expected = algorithm::rotation(cube(), facet, maps, tag::facet{});
+      ASSERT((std::set<Facet<int>>(classes.cbegin(), classes.cend()) == std::set<Facet<int>>(expected.cbegin(), expected.cend())), "Recursive ridge computation must not change the neighbours.");
+      // the facet is a 3-cube with two classes of facets, a square. The square keeps the exchange of its two variables,
+      // so only two of its four edges are computed by elimination.
+      ASSERT(cache.lookups() == 4, "The stabilizer must reduce the ridges at every level of the recursion.");
+   }
+
+   Vertices<int> pyramid()
+   {
+      std::mt19937 generator(11);
+      std::set<Vertex<int>> base;
+      while ( base.size() < 60 )
+      {
+         Vertex<int> vertex{0};
+         for ( int k = 0; k < 9; ++k )
+         {
+            vertex.push_back(static_cast<int>(generator() % 2));
+         }
+         vertex.push_back(1);
+         base.insert(vertex);
+      }
+      Vertices<int> vertices(base.cbegin(), base.cend());
+      Vertex<int> apex(11, 0);
+      apex.front() = 1;
+      apex.back() = 1;
+      vertices.push_back(apex);
+      return vertices;
+   }
+
+   void largeFacet()
+   {
+      const std::size_t thread_count = 4;
+      const auto vertices = pyramid();
+      const Facet<int> facet{-1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+      AdjacencyDecompositionSettings settings;
+      settings.thread_count = thread_count;
+      const auto sequential = [](const std::size_t size, const std::function<void(std::size_t)>& function)
+      {
+         for ( std::size_t k = 0; k < size; ++k )
+         {
+            function(k);
+         }
+      };
+      const auto expected = algorithm::rotation<int>(vertices, facet, Maps(), tag::facet{}, settings, sequential, nullptr);
+      // all other workers wait for a job, so only the one facet is being worked on.
+      WorkStealingPool pool(thread_count);
+      for ( std::size_t i = 1; i < thread_count; ++i )
+      {
+         pool.idle();
+      }
+      const auto worker = std::this_thread::get_id();
+      std::mutex mutex;
+      std::set<std::thread::id> threads;
+      std::atomic<bool> stolen_task(false);
+      std::atomic<std::size_t> tasks(0);
+      const algorithm::ForEach for_each = [&](const std::size_t size, const std::function<void(std::size_t)>& function)
+      {
+         tasks += size;
+         pool.run(size, [&](const std::size_t index)
+         {
+            const auto thread = std::this_thread::get_id();
+            {
+               const std::lock_guard<std::mutex> lock(mutex);
+               threads.insert(thread);
+            }
+            if ( thread != worker )
+            {
+               stolen_task = true;
+            }
+            // the worker holds on to its first task until another thread stole one, so the test does not depend on scheduling.
+            while ( thread == worker && index == 0 && size > 1 && !stolen_task )
+            {
+               std::this_thread::yield();
+            }
+            function(index);
+         });
+      };
+      const auto stolen = algorithm::rotation<int>(vertices, facet, Maps(), tag::facet{}, settings, for_each, nullptr);
+      ASSERT((std::set<Facet<int>>(stolen.cbegin(), stolen.cend()) == std::set<Facet<int>>(expected.cbegin(), expected.cend())), "Idle workers may not change the neighbours.");
+      // without maps, each ridge yields its own neighbour.
+      ASSERT(tasks > expected.size(), "The ridges must be computed in tasks idle workers can steal.");
+      ASSERT(threads.size() > 1, "Idle workers must run tasks of the single large facet.");
+   }
+}
@@ -66,6 +66,13 @@ namespace
       ASSERT(((BI(-6) /= BI(-3)) == BI(2)), "operator/=(BigInteger)");
       ASSERT(((BI(0) /= BI(3)) == BI(0)), "operator/=(BigInteger)");
       ASSERT_ANY_EXCEPTION(((BI(6) /= BI(0)) == BI(0)), "operator/=(BigInteger)");
+      // beyond the range of the built-in types
+      const auto large = BI(int64_t(1) << 62) * BI(int64_t(1) << 40);
+      ASSERT(((-large * BI(3) /= BI(3)) == -large), "operator/=(BigInteger)");
+      ASSERT(((-large * BI(3) /= BI(-3)) == large), "operator/=(BigInteger)");
+      ASSERT(((large * BI(3) /= BI(-3)) == -large), "operator/=(BigInteger)");
+      ASSERT(((-large /= -large) == BI(1)), "operator/=(BigInteger)");
+      ASSERT(((BI(large) /= -large) == BI(-1)), "operator/=(BigInteger)");
    }
 
    void test_operator_add_assign()
@@ -17,6 +17,7 @@ namespace
    void merge();
    void intersect();
    void count();
+   void test();
 }
 
 int main()
@@ -27,6 +28,7 @@ try
    merge();
    intersect();
    count();
+   test();
 }
 catch ( const TestingGearException& e )
 {
@@ -86,5 +88,14 @@ namespace
          ASSERT(a.count(10) == i + 1, "Count mismatch");
       }
    }
+   void test()
+   {
+      BitsetFixedSize<2> a(40);
+      a.set(3);
+      a.set(35);
+      for ( std::size_t i = 0; i < 40; ++i )
+      {
+         ASSERT(a.test(i) == (i == 3 || i == 35), "Only bits 3 and 35 are set");
+      }
+   }
 }
-
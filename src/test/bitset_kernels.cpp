@@ -0,0 +1,124 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "bitset_kernels.h"
+
+#include <random>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   using Words = std::vector<kernels::Word>;
+   bool bit(const Words&, const std::size_t);
+   Words randomWords(std::mt19937&, const std::size_t, const double);
+   void counts();
+   void containment();
+   void merge();
+}
+
+int main()
+try
+{
+   counts();
+   containment();
+   merge();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   bool bit(const Words& words, const std::size_t i)
+   {
+      return (words[i / 64] >> (i % 64)) & 1u;
+   }
+
+   Words randomWords(std::mt19937& generator, const std::size_t size, const double density)
+   {
+      std::bernoulli_distribution coin(density);
+      Words words(size, 0);
+      for ( std::size_t i = 0; i < 64 * size; ++i )
+      {
+         if ( coin(generator) )
+         {
+            words[i / 64] |= kernels::Word(1) << (i % 64);
+         }
+      }
+      return words;
+   }
+
+   // sizes cover the scalar loops as well as full vectors with and without remainder.
+   void counts()
+   {
+      std::mt19937 generator(3);
+      for ( std::size_t size = 1; size <= 35; ++size )
+      {
+         const auto a = randomWords(generator, size, 0.3);
+         const auto b = randomWords(generator, size, 0.6);
+         std::size_t expected_count = 0;
+         std::size_t expected_union = 0;
+         for ( std::size_t i = 0; i < 64 * size; ++i )
+         {
+            expected_count += bit(a, i) ? 1 : 0;
+            expected_union += (bit(a, i) || bit(b, i)) ? 1 : 0;
+         }
+         ASSERT(kernels::count(a.data(), size) == expected_count, "Count mismatch.");
+         ASSERT(kernels::unionCount(a.data(), b.data(), size) == expected_union, "Union count mismatch.");
+      }
+   }
+
+   void containment()
+   {
+      std::mt19937 generator(5);
+      for ( std::size_t size = 1; size <= 35; ++size )
+      {
+         for ( std::size_t k = 0; k < 20; ++k )
+         {
+            const auto a = randomWords(generator, size, 0.9);
+            const auto b = randomWords(generator, size, 0.5);
+            auto inner = randomWords(generator, size, 0.02);
+            // mostly contained, so that all words are compared.
+            for ( std::size_t i = 0; i < size && k % 4 != 3; ++i )
+            {
+               inner[i] &= (k % 2 == 0) ? a[i] : (a[i] | b[i]);
+            }
+            bool expected = true;
+            bool expected_union = true;
+            for ( std::size_t i = 0; i < 64 * size; ++i )
+            {
+               expected = expected && (!bit(inner, i) || bit(a, i));
+               expected_union = expected_union && (!bit(inner, i) || bit(a, i) || bit(b, i));
+            }
+            ASSERT(kernels::contains(a.data(), inner.data(), size) == expected, "Containment mismatch.");
+            ASSERT(kernels::unionContains(a.data(), b.data(), inner.data(), size) == expected_union, "Union containment mismatch.");
+         }
+      }
+   }
+
+   void merge()
+   {
+      std::mt19937 generator(7);
+      for ( std::size_t size = 1; size <= 35; ++size )
+      {
+         auto a = randomWords(generator, size, 0.2);
+         const auto copy = a;
+         const auto b = randomWords(generator, size, 0.2);
+         kernels::merge(a.data(), b.data(), size);
+         for ( std::size_t i = 0; i < 64 * size; ++i )
+         {
+            ASSERT(bit(a, i) == (bit(copy, i) || bit(b, i)), "Merge mismatch.");
+         }
+      }
+   }
+}
+
@@ -0,0 +1,148 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "bitset_sparse.h"
+#include "bitset_variable_size.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   using Pair = std::pair<BitsetSparse, BitsetVariableSize>;
+   Pair randomPair(std::mt19937&, const std::size_t, const std::size_t, const double);
+   void assertSame(const Pair&, const std::size_t);
+   void representations();
+   void operations();
+}
+
+int main()
+try
+{
+   representations();
+   operations();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   /// Sets bits below a random frontier. As in Fourier-Motzkin elimination, most bits are set in increasing order.
+   Pair randomPair(std::mt19937& generator, const std::size_t bits, const std::size_t max, const double density)
+   {
+      std::bernoulli_distribution coin(density);
+      std::uniform_int_distribution<std::size_t> position(0, max - 1);
+      Pair pair{BitsetSparse(bits), BitsetVariableSize(bits)};
+      const auto frontier = position(generator) + 1;
+      for ( std::size_t i = 0; i < frontier; ++i )
+      {
+         if ( coin(generator) )
+         {
+            pair.first.set(i);
+            pair.second.set(i);
+         }
+      }
+      // some bits out of order.
+      for ( std::size_t k = 0; k < 3; ++k )
+      {
+         const auto i = position(generator);
+         pair.first.set(i);
+         pair.second.set(i);
+      }
+      return pair;
+   }
+
+   void assertSame(const Pair& pair, const std::size_t bits)
+   {
+      std::vector<std::size_t> unset;
+      for ( std::size_t i = 0; i < bits; ++i )
+      {
+         ASSERT(pair.first.test(i) == pair.second.test(i), "Test mismatch.");
+         if ( !pair.second.test(i) )
+         {
+            unset.push_back(i);
+         }
+      }
+      ASSERT(unsetBits(pair.first, bits) == unset, "Unset bits mismatch.");
+   }
+
+   void representations()
+   {
+      const std::size_t bits = 50000;
+      BitsetSparse bitset(bits);
+      ASSERT(bitset.sparse(), "New bitset should be sparse.");
+      ASSERT(bitset.count(bits) == 0, "New bitset should be empty.");
+      // few unset bits stay a list, also for many vertices.
+      for ( std::size_t i = 0; i < bits; ++i )
+      {
+         if ( i % 1000 != 0 )
+         {
+            bitset.set(i);
+         }
+      }
+      ASSERT(bitset.sparse(), "Bitset with few unset bits should be sparse.");
+      ASSERT(bitset.count(bits) == bits - 50, "Count mismatch.");
+      ASSERT(!bitset.test(2000) && bitset.test(2001), "Test mismatch.");
+      // many unset bits fall back to words.
+      BitsetSparse half(bits);
+      for ( std::size_t i = 0; i < bits; i += 2 )
+      {
+         half.set(i);
+      }
+      ASSERT(!half.sparse(), "Bitset with many unset bits should be dense.");
+      ASSERT(half.count(bits) == bits / 2, "Count mismatch.");
+      // the union of a dense and a sparse bitset has no unset bits.
+      const auto merged = half.merge(bitset, bits);
+      ASSERT(merged.sparse(), "Union should be sparse.");
+      ASSERT(merged.count(bits) == bits, "Count mismatch.");
+      ASSERT(merged.contains(bitset, bits) && merged.contains(half, bits), "Union should contain its parts.");
+      ASSERT(!bitset.contains(merged, bits), "Union should be larger.");
+   }
+
+   void operations()
+   {
+      std::mt19937 generator(13);
+      for ( const std::size_t bits : {1u, 60u, 64u, 65u, 300u, 2000u} )
+      {
+         for ( const double density : {0.02, 0.5, 0.97, 1.0} )
+         {
+            for ( std::size_t k = 0; k < 30; ++k )
+            {
+               const auto max = bits;
+               const auto a = randomPair(generator, bits, max, density);
+               const auto b = randomPair(generator, bits, max, 1.0 - density / 2);
+               auto inner = randomPair(generator, bits, max, density / 4);
+               assertSame(a, bits);
+               ASSERT(a.first.count(max) == a.second.count(max), "Count mismatch.");
+               ASSERT(BitsetSparse::unionCount(a.first, b.first, max) == BitsetVariableSize::unionCount(a.second, b.second, max), "Union count mismatch.");
+               ASSERT(a.first.contains(inner.first, max) == a.second.contains(inner.second, max), "Containment mismatch.");
+               ASSERT(inner.first.contains(a.first, max) == inner.second.contains(a.second, max), "Containment mismatch.");
+               ASSERT(a.first.equals(b.first, max) == a.second.equals(b.second, max), "Equality mismatch.");
+               ASSERT(BitsetSparse::unionContains(a.first, b.first, inner.first, max) == BitsetVariableSize::unionContains(a.second, b.second, inner.second, max), "Union containment mismatch.");
+               ASSERT(BitsetSparse::unionContains(inner.first, a.first, b.first, max) == BitsetVariableSize::unionContains(inner.second, a.second, b.second, max), "Union containment mismatch.");
+               const Pair merged(a.first.merge(b.first, max), a.second.merge(b.second, max));
+               assertSame(merged, bits);
+               ASSERT(merged.first.equals(b.first.merge(a.first, max), max), "Merge should be symmetric.");
+               ASSERT(BitsetSparse::unionContains(a.first, b.first, merged.first, max), "Union should be contained.");
+               // a contained bitset, so that all positions are compared.
+               inner = Pair(a.first.merge(inner.first, max), a.second.merge(inner.second, max));
+               ASSERT(inner.first.contains(a.first, max), "Containment mismatch.");
+               ASSERT(BitsetSparse::unionContains(inner.first, b.first, a.first, max), "Union containment mismatch.");
+               ASSERT(BitsetSparse::unionContains(b.first, inner.first, a.first, max), "Union containment mismatch.");
+            }
+         }
+      }
+   }
+}
+
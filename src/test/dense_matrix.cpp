@@ -0,0 +1,78 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "dense_matrix.h"
+
+using namespace panda;
+
+namespace
+{
+   void construction();
+   void rows();
+   void columns();
+   void transposition();
+}
+
+int main()
+try
+{
+   construction();
+   rows();
+   columns();
+   transposition();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void construction()
+   {
+      const DenseMatrix<int> zeros(2, 3);
+      ASSERT(zeros.rows() == 2 && zeros.columns() == 3, "Size mismatch.");
+      ASSERT((zeros.toMatrix() == Matrix<int>{{0, 0, 0}, {0, 0, 0}}), "Data mismatch.");
+      const Matrix<int> m{{1, 2}, {3, 4}, {5, 6}};
+      const DenseMatrix<int> dense(m);
+      ASSERT(dense.rows() == 3 && dense.columns() == 2, "Size mismatch.");
+      ASSERT(dense[1][0] == 3 && dense[2][1] == 6, "Data mismatch.");
+      ASSERT(dense[0] + dense.columns() == dense[1], "Rows are stored with a fixed stride.");
+      ASSERT(dense.toMatrix() == m, "Conversion is not lossless.");
+      ASSERT(DenseMatrix<int>(Matrix<int>{}).empty(), "Empty matrix is not empty.");
+   }
+
+   void rows()
+   {
+      DenseMatrix<int> dense(Matrix<int>{{1, 2}, {3, 4}, {5, 6}, {7, 8}});
+      dense.swapRows(0, 2);
+      ASSERT((dense.row(0) == Row<int>{5, 6} && dense.row(2) == Row<int>{1, 2}), "Swap mismatch.");
+      dense.eraseRows(1, 3);
+      ASSERT((dense.toMatrix() == Matrix<int>{{5, 6}, {7, 8}}), "Erase mismatch.");
+      dense.resizeRows(3);
+      ASSERT((dense.toMatrix() == Matrix<int>{{5, 6}, {7, 8}, {0, 0}}), "New rows must be zero.");
+   }
+
+   void columns()
+   {
+      DenseMatrix<int> dense(Matrix<int>{{1, 2, 3}, {4, 5, 6}});
+      dense.eraseColumn(1);
+      ASSERT((dense.toMatrix() == Matrix<int>{{1, 3}, {4, 6}}), "Erase mismatch.");
+      dense.eraseColumn(0);
+      ASSERT((dense.toMatrix() == Matrix<int>{{3}, {6}}), "Erase mismatch.");
+   }
+
+   void transposition()
+   {
+      const DenseMatrix<int> dense(Matrix<int>{{1, 5}, {2, 6}, {3, 7}, {4, 8}});
+      ASSERT((dense.transposed().toMatrix() == Matrix<int>{{1, 2, 3, 4}, {5, 6, 7, 8}}), "Data mismatch.");
+      ASSERT((dense.toMatrix() == Matrix<int>{{1, 5}, {2, 6}, {3, 7}, {4, 8}}), "transposed is not allowed to modify inplace");
+   }
+}
+
@@ -0,0 +1,104 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "distance_engine.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "algorithm_inequality_operations.h"
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void distances();
+   void batch();
+   void extremalVertices();
+   void zeroDistance();
+   void overflow();
+}
+
+int main()
+try
+{
+   distances();
+   batch();
+   extremalVertices();
+   zeroDistance();
+   overflow();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   const Vertices<int> square{{0, 0, 1}, {0, 1, 1}, {1, 0, 1}, {1, 1, 1}, {-1, 1, 1}, {2, 1, 1}};
+
+   void distances()
+   {
+      const DistanceEngine<int> engine(square);
+      ASSERT(engine.size() == square.size(), "Size mismatch.");
+      const Inequality<int> inequality{1, 0, -1};
+      const auto values = engine.distances(inequality);
+      ASSERT(values.size() == square.size(), "Size mismatch.");
+      for ( std::size_t i = 0; i < square.size(); ++i )
+      {
+         ASSERT(values[i] == algorithm::distance(inequality, square[i]), "Bad distance.");
+      }
+      const DistanceEngine<BigInteger> big_engine(Vertices<BigInteger>{{BigInteger(2), BigInteger(1), BigInteger(1)}});
+      ASSERT(big_engine.distances(Inequality<BigInteger>{BigInteger(1), BigInteger(0), BigInteger(-1)}).front() == BigInteger(-1), "Bad distance.");
+   }
+
+   void batch()
+   {
+      const DistanceEngine<int64_t> engine(Vertices<int64_t>{{0, 0, 1}, {3, 1, 1}, {-1, 2, 1}});
+      const Inequalities<int64_t> inequalities{{1, 0, -1}, {0, 1, 0}, {1, 1, -2}};
+      const auto values = engine.distances(inequalities);
+      ASSERT(values.rows() == 3 && values.columns() == 3, "Size mismatch.");
+      for ( std::size_t k = 0; k < inequalities.size(); ++k )
+      {
+         const auto row = engine.distances(inequalities[k]);
+         ASSERT((values.row(k) == Row<int64_t>(row.cbegin(), row.cend())), "The batch must agree with single evaluations.");
+      }
+   }
+
+   void extremalVertices()
+   {
+      const DistanceEngine<int> engine(square);
+      // ties are broken by the first vertex, as in algorithm::furthestVertex and algorithm::nearestVertex.
+      ASSERT(engine.furthest(Inequality<int>{1, 0, -1}) == 4, "Bad furthest vertex.");
+      ASSERT(engine.nearest(Inequality<int>{1, 0, -1}) == 5, "Bad nearest vertex.");
+      ASSERT(engine.furthest(Inequality<int>{0, 1, -1}) == 0, "Ties must be broken by the first vertex.");
+      ASSERT(engine.nearest(Inequality<int>{0, 1, -1}) == 1, "Ties must be broken by the first vertex.");
+   }
+
+   void zeroDistance()
+   {
+      const DistanceEngine<int> engine(square);
+      ASSERT((engine.zeroDistance(Inequality<int>{0, 1, -1}) == std::vector<std::size_t>{1, 3, 4, 5}), "Bad vertices on the face.");
+      ASSERT(engine.zeroDistance(Inequality<int>{0, 1, -2}).empty(), "No vertex lies on the face.");
+   }
+
+   void overflow()
+   {
+      const auto large = std::numeric_limits<int32_t>::max() / 2 + 1;
+      const DistanceEngine<int32_t> engine(Vertices<int32_t>{{large, large, 1}, {0, 1, 1}});
+      // the bound on the magnitudes is exceeded, but the distances themselves fit.
+      ASSERT_NOTHROW(engine.distances(Inequality<int32_t>{1, -1, 0}), "The distances fit into the integer type.");
+      ASSERT(engine.distances(Inequality<int32_t>{1, -1, 0}).front() == 0, "Bad distance.");
+      ASSERT(engine.distances(Inequality<int32_t>{1, 1, 0}).front() == std::numeric_limits<int32_t>::min(), "Bad distance.");
+      ASSERT_EXCEPTION(engine.distances(Inequality<int32_t>{2, 0, 0}), std::overflow_error, "The product must overflow.");
+      ASSERT_EXCEPTION(engine.furthest(Inequality<int32_t>{1, 1, 1}), std::overflow_error, "The sum must overflow.");
+   }
+}
@@ -0,0 +1,111 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "fourier_motzkin_checkpoint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "bitset_variable_size.h"
+
+using namespace panda;
+
+namespace
+{
+   void integers();
+   template <typename Integer>
+   void roundTrip();
+   void rejection();
+}
+
+int main()
+try
+{
+   integers();
+   roundTrip<int>();
+   roundTrip<SafeInteger>();
+   roundTrip<BigInteger>();
+   rejection();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void integers()
+   {
+      std::stringstream stream;
+      writeBinary(stream, BigInteger(int64_t(-1234567890123456789)) * BigInteger(int64_t(1000000007)));
+      writeBinary(stream, SafeInteger(int64_t(-42)));
+      writeBinary(stream, int16_t(-7));
+      BigInteger big;
+      SafeInteger safe;
+      int16_t small = 0;
+      readBinary(stream, big);
+      readBinary(stream, safe);
+      readBinary(stream, small);
+      ASSERT(big == BigInteger(int64_t(-1234567890123456789)) * BigInteger(int64_t(1000000007)), "BigInteger mismatch.");
+      ASSERT(safe == -42, "SafeInteger mismatch.");
+      ASSERT(small == -7, "int16_t mismatch.");
+   }
+
+   template <typename Integer>
+   FourierMotzkinState<Integer, BitsetVariableSize> exampleState()
+   {
+      FourierMotzkinState<Integer, BitsetVariableSize> state{0, 0, 0.0, Vertices<Integer>(), DenseMatrix<Integer>(), std::vector<BitsetVariableSize>()};
+      state.vertices = Vertices<Integer>(70, Vertex<Integer>(2, Integer(1)));
+      state.vertices[3][1] = Integer(-5);
+      state.matrix = DenseMatrix<Integer>(Matrix<Integer>{{Integer(1), Integer(-2)}, {Integer(0), Integer(3)}});
+      state.R.assign(2, BitsetVariableSize(70));
+      state.R[0].set(0);
+      state.R[1].set(65);
+      state.fingerprint = fourierMotzkinFingerprint(state.matrix, state.vertices, 0);
+      state.step = 4;
+      state.survival = 0.25;
+      return state;
+   }
+
+   template <typename Integer>
+   void roundTrip()
+   {
+      const std::string filename = "fourier_motzkin_checkpoint.test";
+      const auto state = exampleState<Integer>();
+      writeCheckpoint(filename, state);
+      const auto read = readCheckpoint<Integer, BitsetVariableSize>(filename, state.fingerprint);
+      std::remove(filename.c_str());
+      ASSERT(read.step == 4 && std::memcmp(&read.survival, &state.survival, sizeof(double)) == 0, "Step mismatch.");
+      ASSERT(read.vertices == state.vertices, "Vertices mismatch.");
+      ASSERT(read.matrix.toMatrix() == state.matrix.toMatrix(), "Matrix mismatch.");
+      ASSERT(read.R.size() == 2, "Bitset count mismatch.");
+      for ( std::size_t i = 0; i < 70; ++i )
+      {
+         ASSERT(read.R[0].test(i) == (i == 0) && read.R[1].test(i) == (i == 65), "Bitset mismatch.");
+      }
+   }
+
+   void rejection()
+   {
+      const std::string filename = "fourier_motzkin_checkpoint.test";
+      const auto state = exampleState<int>();
+      writeCheckpoint(filename, state);
+      ASSERT_EXCEPTION((readCheckpoint<int, BitsetVariableSize>(filename, state.fingerprint + 1)), std::invalid_argument, "Fingerprint mismatch must be detected.");
+      {
+         std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+         file << "PANDACP1";
+      }
+      ASSERT_EXCEPTION((readCheckpoint<int, BitsetVariableSize>(filename, state.fingerprint)), std::invalid_argument, "Truncated files must be detected.");
+      std::remove(filename.c_str());
+   }
+}
+
@@ -21,6 +21,7 @@ namespace
    void shortOption32();
    void shortOption64();
    void shortOptionInf();
+   void shortOptionAdaptive();
    void longOptionBad();
    void longOption16();
    void longOption32();
@@ -37,6 +38,7 @@ try
    shortOption32();
    shortOption64();
    shortOptionInf();
+   shortOptionAdaptive();
    longOptionBad();
    longOption16();
    longOption32();
@@ -146,6 +148,22 @@ namespace
          delete [] argv;
       }
    }
+   void shortOptionAdaptive()
+   {
+      {
+         char** argv = new char*[3];
+         argv[0] = nullptr;
+         argv[1] = new char[3];
+         strcpy(argv[1], "-i");
+         argv[2] = new char[9];
+         strcpy(argv[2], "adaptive");
+         ASSERT_NOTHROW((integerType(3, argv)), "");
+         ASSERT((integerType(3, argv) == IntegerType::Adaptive), "");
+         delete [] argv[2];
+         delete [] argv[1];
+         delete [] argv;
+      }
+   }
    void longOptionBad()
    {
       {
@@ -0,0 +1,117 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "minimal_subset_index.h"
+
+#include <random>
+#include <vector>
+
+#include "bitset_fixed_size.h"
+#include "bitset_variable_size.h"
+
+using namespace panda;
+
+namespace
+{
+   void equalSets();
+   void subsets();
+   void randomized();
+}
+
+int main()
+try
+{
+   equalSets();
+   subsets();
+   randomized();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void equalSets()
+   {
+      MinimalSubsetIndex<BitsetFixedSize<1>, int> index(10);
+      BitsetFixedSize<1> a(10);
+      a.set(3);
+      ASSERT(index.insert(a, 1), "First set is inserted");
+      ASSERT(!index.insert(a, 2), "Equal set is rejected");
+      const auto result = index.release();
+      ASSERT(result.size() == 1 && result.front().second == 1, "First of equal sets is kept");
+      ASSERT(index.release().empty(), "Release clears the index");
+   }
+
+   void subsets()
+   {
+      MinimalSubsetIndex<BitsetVariableSize, int> index(70);
+      BitsetVariableSize a(70);
+      a.set(1);
+      a.set(65);
+      BitsetVariableSize b = a;
+      b.set(2);
+      BitsetVariableSize c(70);
+      c.set(2);
+      ASSERT(index.insert(b, 1), "{1, 2, 65} is inserted");
+      ASSERT(index.insert(a, 2), "{1, 65} is inserted");
+      ASSERT(!index.insert(b, 3), "{1, 2, 65} has a subset");
+      ASSERT(index.insert(c, 4), "{2} is inserted");
+      const auto result = index.release();
+      ASSERT(result.size() == 2, "{1, 2, 65} is not minimal");
+      ASSERT(result[0].second == 2 && result[1].second == 4, "Order of insertion is kept");
+   }
+
+   void randomized()
+   {
+      std::mt19937 generator(7);
+      std::bernoulli_distribution coin(0.8);
+      const std::size_t bits = 12;
+      std::vector<BitsetVariableSize> sets;
+      for ( std::size_t k = 0; k < 300; ++k )
+      {
+         sets.emplace_back(bits);
+         for ( std::size_t i = 0; i < bits; ++i )
+         {
+            if ( coin(generator) )
+            {
+               sets.back().set(i);
+            }
+         }
+      }
+      MinimalSubsetIndex<BitsetVariableSize, std::size_t> index(bits);
+      for ( std::size_t k = 0; k < sets.size(); ++k )
+      {
+         index.insert(sets[k], k);
+      }
+      std::vector<std::size_t> expected;
+      for ( std::size_t k = 0; k < sets.size(); ++k )
+      {
+         bool minimal = true;
+         for ( std::size_t j = 0; j < sets.size() && minimal; ++j )
+         {
+            const auto is_subset = sets[k].contains(sets[j], bits);
+            const auto is_equal = is_subset && sets[j].contains(sets[k], bits);
+            minimal = !(is_subset && (!is_equal || j < k));
+         }
+         if ( minimal )
+         {
+            expected.push_back(k);
+         }
+      }
+      const auto result = index.release();
+      ASSERT(result.size() == expected.size(), "Number of minimal sets mismatch");
+      for ( std::size_t k = 0; k < result.size(); ++k )
+      {
+         ASSERT(result[k].second == expected[k], "Minimal sets mismatch");
+      }
+   }
+}
+
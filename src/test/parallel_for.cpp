@@ -0,0 +1,90 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "parallel_for.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   void chunks();
+   void coverage();
+   void exceptions();
+}
+
+int main()
+try
+{
+   chunks();
+   coverage();
+   exceptions();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void chunks()
+   {
+      ASSERT(chunkCount(0, 4) == 0, "Empty range has no chunks.");
+      ASSERT(chunkCount(100, 1) == 1, "Single thread uses a single chunk.");
+      ASSERT(chunkCount(3, 8) == 3, "There are never more chunks than indices.");
+      ASSERT(chunkCount(1000, 8) >= 8, "Every thread gets at least one chunk.");
+   }
+
+   void coverage()
+   {
+      for ( const std::size_t thread_count : {1u, 2u, 3u, 8u} )
+      {
+         for ( const std::size_t size : {0u, 1u, 7u, 100u, 1001u} )
+         {
+            std::vector<int> hits(size, 0);
+            std::vector<std::size_t> begins(chunkCount(size, thread_count), size + 1);
+            parallelFor(size, thread_count, [&](const std::size_t chunk, const std::size_t begin, const std::size_t end)
+            {
+               begins[chunk] = begin;
+               for ( auto i = begin; i < end; ++i )
+               {
+                  ++hits[i];
+               }
+            });
+            for ( const auto hit : hits )
+            {
+               ASSERT(hit == 1, "Each index must be visited exactly once.");
+            }
+            for ( std::size_t chunk = 1; chunk < begins.size(); ++chunk )
+            {
+               ASSERT(begins[chunk - 1] < begins[chunk], "Chunks must be ordered by index.");
+            }
+         }
+      }
+   }
+
+   void exceptions()
+   {
+      std::atomic<std::size_t> calls(0);
+      const auto throwing = [&](const std::size_t chunk, const std::size_t, const std::size_t)
+      {
+         ++calls;
+         if ( chunk == 2 )
+         {
+            throw std::invalid_argument("chunk 2");
+         }
+      };
+      ASSERT_EXCEPTION(parallelFor(100, 4, throwing), std::invalid_argument, "Exceptions must be propagated to the caller.");
+      ASSERT(calls == chunkCount(100, 4), "Remaining chunks must still be processed.");
+   }
+}
+
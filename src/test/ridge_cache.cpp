@@ -0,0 +1,89 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "ridge_cache.h"
+
+#include <set>
+
+#include "algorithm_fourier_motzkin_elimination.h"
+
+using namespace panda;
+
+namespace
+{
+   void permutedVertices();
+   void differentVertices();
+   void eviction();
+}
+
+int main()
+try
+{
+   permutedVertices();
+   differentVertices();
+   eviction();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   Inequalities<int> compute(const Vertices<int>& vertices)
+   {
+      return algorithm::fourierMotzkinElimination(vertices);
+   }
+
+   std::set<Row<int>> asSet(const Matrix<int>& matrix)
+   {
+      return std::set<Row<int>>(matrix.cbegin(), matrix.cend());
+   }
+
+   void permutedVertices()
+   {
+      RidgeCache<int> cache(0);
+      const Vertices<int> first{{0, 0, 0, 1}, {2, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}};
+      // the first two coordinates exchanged, the vertices in a different order.
+      const Vertices<int> second{{0, 0, 1, 1}, {0, 0, 0, 1}, {1, 0, 0, 1}, {0, 2, 0, 1}};
+      ASSERT((asSet(cache.ridges(first, compute)) == asSet(compute(first))), "A miss must return the computed ridges.");
+      ASSERT((asSet(cache.ridges(second, compute)) == asSet(compute(second))), "A hit must return the permuted ridges.");
+      ASSERT(cache.lookups() == 2, "Both calls are lookups.");
+      ASSERT(cache.hits() == 1, "The permuted vertices must be found in the cache.");
+   }
+
+   void differentVertices()
+   {
+      RidgeCache<int> cache(0);
+      const Vertices<int> first{{0, 0, 0, 1}, {2, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}};
+      const Vertices<int> second{{0, 0, 0, 1}, {3, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}};
+      cache.ridges(first, compute);
+      ASSERT((asSet(cache.ridges(second, compute)) == asSet(compute(second))), "Vertices not equal up to permutation must be computed.");
+      ASSERT(cache.hits() == 0, "Vertices not equal up to permutation must not be found in the cache.");
+   }
+
+   void eviction()
+   {
+      const Vertices<int> first{{0, 0, 0, 1}, {2, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}};
+      const Vertices<int> second{{0, 0, 0, 1}, {3, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1}};
+      // the vertices and the four ridges of a simplex in dimension 3 take 32 integers, the limit holds one entry.
+      RidgeCache<int> cache(40 * sizeof(int));
+      cache.ridges(first, compute);
+      cache.ridges(second, compute);
+      ASSERT(cache.evictions() == 1, "The older entry must be evicted.");
+      ASSERT((asSet(cache.ridges(second, compute)) == asSet(compute(second))), "The newer entry must be kept.");
+      ASSERT(cache.hits() == 1, "The newer entry must be found in the cache.");
+      cache.ridges(first, compute);
+      ASSERT(cache.hits() == 1, "The evicted entry must be computed again.");
+      ASSERT(cache.evictions() == 2, "Storing the evicted entry again evicts the other one.");
+      RidgeCache<int> small(sizeof(int));
+      ASSERT((asSet(small.ridges(first, compute)) == asSet(compute(first))), "An entry exceeding the limit must still be computed.");
+      small.ridges(first, compute);
+      ASSERT(small.hits() == 0 && small.evictions() == 0, "An entry exceeding the limit must not be stored.");
+   }
+}
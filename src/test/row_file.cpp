@@ -0,0 +1,87 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "row_file.h"
+
+#include "big_integer.h"
+
+using namespace panda;
+
+namespace
+{
+   void empty();
+   template <typename Integer>
+   void blocks();
+   void appendAfterRead();
+}
+
+int main()
+try
+{
+   empty();
+   blocks<int>();
+   blocks<BigInteger>();
+   appendAfterRead();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void empty()
+   {
+      RowFile<int> file(3, 2);
+      ASSERT(file.rows() == 0 && file.columns() == 3 && file.blockSize() == 2, "Sizes of an empty file.");
+      ASSERT(file.blocks() == 0, "An empty file has no blocks.");
+   }
+
+   template <typename Integer>
+   void blocks()
+   {
+      DenseMatrix<Integer> rows(7, 3);
+      for ( std::size_t j = 0; j < rows.rows(); ++j )
+      {
+         for ( std::size_t k = 0; k < rows.columns(); ++k )
+         {
+            rows[j][k] = Integer(static_cast<int>(j * 10 + k)) - Integer(20);
+         }
+      }
+      rows[6][2] = Integer(-2000000000);
+      RowFile<Integer> file(3, 3);
+      for ( std::size_t j = 0; j < rows.rows(); ++j )
+      {
+         file.append(rows[j]);
+      }
+      ASSERT(file.rows() == 7 && file.blocks() == 3, "Seven rows need three blocks of three rows.");
+      // blocks are read in arbitrary order.
+      for ( const std::size_t b : {2u, 0u, 1u, 0u} )
+      {
+         const auto block = file.block(b);
+         ASSERT(block.rows() == (b == 2 ? 1u : 3u), "Only the last block may be incomplete.");
+         for ( std::size_t r = 0; r < block.rows(); ++r )
+         {
+            ASSERT(std::equal(block[r], block[r] + 3, rows[b * 3 + r]), "Rows must be read back unchanged.");
+         }
+      }
+   }
+
+   void appendAfterRead()
+   {
+      RowFile<int> file(2, 1);
+      const int a[] = {1, 2};
+      const int b[] = {3, 4};
+      file.append(a);
+      ASSERT(file.block(0)[0][1] == 2, "First row is read back.");
+      file.append(b);
+      ASSERT(file.block(1)[0][0] == 3 && file.block(0)[0][0] == 1, "Rows appended after reading are not overwritten.");
+   }
+}
+
@@ -0,0 +1,102 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "transposed_incidence_matrix.h"
+
+#include <random>
+#include <vector>
+
+#include "bitset_variable_size.h"
+
+using namespace panda;
+
+namespace
+{
+   void empty();
+   void small();
+   void randomized();
+}
+
+int main()
+try
+{
+   empty();
+   small();
+   randomized();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void empty()
+   {
+      const std::vector<BitsetVariableSize> bitsets(3, BitsetVariableSize(10));
+      const TransposedIncidenceMatrix matrix(bitsets, {}, 10);
+      std::vector<TransposedIncidenceMatrix::DataType> buffer;
+      ASSERT(matrix.size() == 0, "No bitsets indexed");
+      ASSERT(!matrix.unionContainsAny(bitsets[0], bitsets[1], buffer), "Nothing can be contained without indexed bitsets");
+   }
+
+   void small()
+   {
+      std::vector<BitsetVariableSize> bitsets(4, BitsetVariableSize(6));
+      bitsets[0].set(1);
+      bitsets[1].set(2);
+      bitsets[2].set(1);
+      bitsets[2].set(2);
+      bitsets[3].set(4);
+      const TransposedIncidenceMatrix matrix(bitsets, {2, 3}, 6);
+      std::vector<TransposedIncidenceMatrix::DataType> buffer;
+      ASSERT(matrix.size() == 2, "Two bitsets indexed");
+      ASSERT(matrix.unionContainsAny(bitsets[0], bitsets[1], buffer), "{1, 2} is contained in {1} u {2}");
+      ASSERT(!matrix.unionContainsAny(bitsets[0], bitsets[0], buffer), "Neither {1, 2} nor {4} is contained in {1}");
+      ASSERT(matrix.unionContainsAny(bitsets[3], bitsets[3], buffer), "{4} is contained in {4}");
+   }
+
+   void randomized()
+   {
+      std::mt19937 generator(42);
+      std::bernoulli_distribution coin(0.3);
+      const std::size_t bits = 70;
+      std::vector<BitsetVariableSize> bitsets(100, BitsetVariableSize(bits));
+      for ( auto& bitset : bitsets )
+      {
+         for ( std::size_t i = 0; i < bits; ++i )
+         {
+            if ( coin(generator) )
+            {
+               bitset.set(i);
+            }
+         }
+      }
+      std::vector<std::size_t> indices;
+      for ( std::size_t k = 40; k < bitsets.size(); ++k )
+      {
+         indices.push_back(k);
+      }
+      const TransposedIncidenceMatrix matrix(bitsets, indices, bits);
+      std::vector<TransposedIncidenceMatrix::DataType> buffer;
+      for ( std::size_t a = 0; a < 40; ++a )
+      {
+         for ( std::size_t b = 0; b < 40; ++b )
+         {
+            bool expected = false;
+            for ( const auto k : indices )
+            {
+               expected = expected || BitsetVariableSize::unionContains(bitsets[a], bitsets[b], bitsets[k], bits);
+            }
+            ASSERT(matrix.unionContainsAny(bitsets[a], bitsets[b], buffer) == expected, "Transposed check must agree with the scan");
+         }
+      }
+   }
+}
+
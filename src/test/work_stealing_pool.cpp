@@ -0,0 +1,115 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "testing_gear.h"
+
+#include "work_stealing_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace panda;
+
+namespace
+{
+   void coverage();
+   void stealing();
+   void exceptions();
+}
+
+int main()
+try
+{
+   coverage();
+   stealing();
+   exceptions();
+}
+catch ( const TestingGearException& e )
+{
+   std::cerr << e.what() << "\n";
+   return 1;
+}
+
+namespace
+{
+   void coverage()
+   {
+      for ( const std::size_t thread_count : {1u, 2u, 4u} )
+      {
+         WorkStealingPool pool(thread_count);
+         for ( std::size_t i = 1; i < thread_count; ++i )
+         {
+            pool.idle();
+         }
+         for ( const std::size_t size : {0u, 1u, 7u, 100u} )
+         {
+            std::vector<std::atomic<int>> hits(size);
+            for ( auto& hit : hits )
+            {
+               hit = 0;
+            }
+            pool.run(size, [&](const std::size_t k)
+            {
+               ++hits[k];
+            });
+            for ( const auto& hit : hits )
+            {
+               ASSERT(hit == 1, "Each index must be visited exactly once.");
+            }
+         }
+      }
+   }
+
+   void stealing()
+   {
+      WorkStealingPool pool(2);
+      pool.idle();
+      std::mutex mutex;
+      std::condition_variable condition;
+      bool second_done = false;
+      std::thread::id second_thread;
+      bool stolen = false;
+      pool.run(2, [&](const std::size_t k)
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         if ( k == 0 )
+         {
+            // the worker holds on to its first task until the second one was stolen.
+            stolen = condition.wait_for(lock, std::chrono::seconds(10), [&]() { return second_done; });
+         }
+         else
+         {
+            second_thread = std::this_thread::get_id();
+            second_done = true;
+            condition.notify_all();
+         }
+      });
+      ASSERT(stolen, "An idle worker must steal a task.");
+      ASSERT(second_thread != std::this_thread::get_id(), "The stolen task must run on another thread.");
+   }
+
+   void exceptions()
+   {
+      WorkStealingPool pool(3);
+      pool.idle();
+      pool.idle();
+      std::atomic<std::size_t> calls(0);
+      const auto throwing = [&](const std::size_t k)
+      {
+         ++calls;
+         if ( k == 5 )
+         {
+            throw std::invalid_argument("task 5");
+         }
+      };
+      ASSERT_EXCEPTION(pool.run(20, throwing), std::invalid_argument, "Exceptions must be propagated to the caller.");
+      ASSERT(calls == 20, "Remaining tasks must still be processed.");
+   }
+}
@@ -0,0 +1,38 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "transposed_incidence_matrix.h"
+
+using namespace panda;
+
+std::size_t panda::TransposedIncidenceMatrix::size() const noexcept
+{
+   return rows;
+}
+
+bool panda::TransposedIncidenceMatrix::intersect(std::vector<DataType>& buffer, const std::size_t column) const noexcept
+{
+   assert( buffer.size() == words_per_column );
+   const auto offset = column * words_per_column;
+   DataType any = 0;
+   for ( std::size_t w = 0; w < words_per_column; ++w )
+   {
+      buffer[w] &= data[offset + w];
+      any |= buffer[w];
+   }
+   return any != 0;
+}
+
+void panda::TransposedIncidenceMatrix::fill(std::vector<DataType>& buffer) const
+{
+   const auto digits = static_cast<std::size_t>(std::numeric_limits<DataType>::digits);
+   buffer.assign(words_per_column, ~static_cast<DataType>(0u));
+   if ( rows % digits != 0 )
+   {
+      buffer.back() = (static_cast<DataType>(1u) << (rows % digits)) - 1;
+   }
+}
+
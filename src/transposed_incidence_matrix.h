@@ -0,0 +1,48 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitset_kernels.h"
+
+namespace panda
+{
+   /// Column-major view of a set of bitsets: for every bit position, a bit per bitset that is set if and only if
+   /// the bitset does not have this bit set. In Fourier-Motzkin elimination, bitsets hold the vertices a row is not
+   /// incident to, so each column holds the rows incident to a vertex.
+   /// Checking whether any bitset is a subset of a given union reduces to intersecting the columns of the complement.
+   class TransposedIncidenceMatrix
+   {
+      public:
+         /// Underlying data type.
+         using DataType = kernels::Word;
+         /// Constructor: builds the columns [0, max) of the bitsets selected by the indices.
+         template <typename Bitset>
+         TransposedIncidenceMatrix(const std::vector<Bitset>&, const std::vector<std::size_t>&, const std::size_t);
+         /// Checks if any of the indexed bitsets is contained in the union of the two bitsets.
+         /// The buffer is used as scratch space to avoid allocations.
+         template <typename Bitset>
+         bool unionContainsAny(const Bitset&, const Bitset&, std::vector<DataType>&) const;
+         /// Returns the number of indexed bitsets.
+         std::size_t size() const noexcept;
+      private:
+         /// Intersects the buffer with a column. Returns true if the result is not empty.
+         bool intersect(std::vector<DataType>&, const std::size_t) const noexcept;
+         /// Fills the buffer with the bits of all indexed bitsets.
+         void fill(std::vector<DataType>&) const;
+         std::size_t rows;
+         std::size_t columns;
+         std::size_t words_per_column;
+         std::vector<DataType> data;
+   };
+}
+
+#include "transposed_incidence_matrix.tpp"
+
@@ -0,0 +1,48 @@
+
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include <cassert>
+#include <limits>
+
+template <typename Bitset>
+panda::TransposedIncidenceMatrix::TransposedIncidenceMatrix(const std::vector<Bitset>& bitsets, const std::vector<std::size_t>& indices, const std::size_t max)
+:
+   rows(indices.size()),
+   columns(max),
+   words_per_column((indices.size() + std::numeric_limits<DataType>::digits - 1) / std::numeric_limits<DataType>::digits),
+   data(max * words_per_column, 0)
+{
+   const auto digits = static_cast<std::size_t>(std::numeric_limits<DataType>::digits);
+   for ( std::size_t k = 0; k < indices.size(); ++k )
+   {
+      const auto& bitset = bitsets[indices[k]];
+      const auto mask = static_cast<DataType>(1u) << (k % digits);
+      for ( std::size_t column = 0; column < columns; ++column )
+      {
+         if ( !bitset.test(column) )
+         {
+            data[column * words_per_column + k / digits] |= mask;
+         }
+      }
+   }
+}
+
+template <typename Bitset>
+bool panda::TransposedIncidenceMatrix::unionContainsAny(const Bitset& a, const Bitset& b, std::vector<DataType>& buffer) const
+{
+   // a bitset is contained in the union iff it is incident to every element outside of the union.
+   fill(buffer);
+   bool any = (rows > 0);
+   for ( std::size_t column = 0; column < columns && any; ++column )
+   {
+      if ( !a.test(column) && !b.test(column) )
+      {
+         any = intersect(buffer, column);
+      }
+   }
+   return any;
+}
+
@@ -0,0 +1,137 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace panda;
+
+panda::WorkStealingPool::WorkStealingPool(const std::size_t thread_count)
+:
+   mutex(),
+   stealable(),
+   finished(),
+   batches(),
+   idle_workers(0),
+   active_helpers(0),
+   stopped(false),
+   helpers()
+{
+   // a task is only stolen while its worker is busy, so at most all other workers are idle.
+   for ( std::size_t i = 1; i < thread_count; ++i )
+   {
+      helpers.emplace_front([this]()
+      {
+         help();
+      });
+   }
+}
+
+panda::WorkStealingPool::~WorkStealingPool()
+{
+   {
+      const std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+   }
+   stealable.notify_all();
+   helpers.clear();
+}
+
+void panda::WorkStealingPool::run(const std::size_t size, const std::function<void(std::size_t)>& function)
+{
+   if ( size == 0 )
+   {
+      return;
+   }
+   Batch batch{&function, size, 0, 0, nullptr};
+   std::unique_lock<std::mutex> lock(mutex);
+   batches.push_back(&batch);
+   stealable.notify_all();
+   while ( batch.next < batch.size )
+   {
+      execute(batch, lock);
+   }
+   finished.wait(lock, [&batch]()
+   {
+      return batch.finished == batch.size;
+   });
+   if ( batch.exception )
+   {
+      std::rethrow_exception(batch.exception);
+   }
+}
+
+void panda::WorkStealingPool::idle()
+{
+   {
+      const std::lock_guard<std::mutex> lock(mutex);
+      ++idle_workers;
+   }
+   stealable.notify_all();
+}
+
+void panda::WorkStealingPool::busy()
+{
+   const std::lock_guard<std::mutex> lock(mutex);
+   assert( idle_workers > 0 );
+   --idle_workers;
+}
+
+void panda::WorkStealingPool::help()
+{
+   std::unique_lock<std::mutex> lock(mutex);
+   while ( true )
+   {
+      stealable.wait(lock, [this]()
+      {
+         return stopped || (active_helpers < idle_workers && !batches.empty());
+      });
+      if ( stopped )
+      {
+         return;
+      }
+      // stealing from the batch with the most remaining tasks splits the largest job first.
+      const auto victim = std::max_element(batches.cbegin(), batches.cend(), [](const Batch* a, const Batch* b)
+      {
+         return a->size - a->next < b->size - b->next;
+      });
+      ++active_helpers;
+      execute(**victim, lock);
+      --active_helpers;
+      stealable.notify_one();
+   }
+}
+
+void panda::WorkStealingPool::execute(Batch& batch, std::unique_lock<std::mutex>& lock)
+{
+   assert( batch.next < batch.size );
+   const auto index = batch.next++;
+   if ( batch.next == batch.size )
+   {
+      // only batches with tasks left can be stolen from.
+      batches.remove(&batch);
+   }
+   lock.unlock();
+   std::exception_ptr exception;
+   try
+   {
+      (*batch.function)(index);
+   }
+   catch ( ... )
+   {
+      exception = std::current_exception();
+   }
+   lock.lock();
+   if ( exception && !batch.exception )
+   {
+      batch.exception = exception;
+   }
+   if ( ++batch.finished == batch.size )
+   {
+      finished.notify_all();
+   }
+}
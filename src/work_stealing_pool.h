@@ -0,0 +1,65 @@
+//-------------------------------------------------------------------------------//
+// Author: Stefan Lörwald, Universität Heidelberg                                //
+// License: CC BY-NC 4.0 http://creativecommons.org/licenses/by-nc/4.0/legalcode //
+//-------------------------------------------------------------------------------//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include "joining_thread.h"
+
+namespace panda
+{
+   /// Pool in which busy workers split their job into independent tasks and idle workers steal them.
+   /// A worker that waits for a new job lends its thread to the pool: while it is idle, one of the
+   /// helper threads of the pool may work on stolen tasks, so at most the given number of threads run.
+   class WorkStealingPool
+   {
+      public:
+         /// Constructor taking the number of workers, which are all busy initially.
+         explicit WorkStealingPool(const std::size_t);
+         /// Destructor, which stops the helper threads.
+         ~WorkStealingPool();
+         /// Calls the function for all indices in [0, size). The calling worker takes the indices in order,
+         /// idle workers steal the remaining ones. Returns after all calls finished, the first exception is rethrown.
+         void run(const std::size_t, const std::function<void(std::size_t)>&);
+         /// Marks the calling worker as waiting for a job, its thread may be used to steal tasks.
+         void idle();
+         /// Marks the calling worker as working on a job again.
+         void busy();
+         /// Copy construction is not allowed.
+         WorkStealingPool(const WorkStealingPool&) = delete;
+         /// Copy assignment is not allowed.
+         WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+      private:
+         /// The tasks of one call of run.
+         struct Batch
+         {
+            const std::function<void(std::size_t)>* function;
+            std::size_t size;
+            std::size_t next;
+            std::size_t finished;
+            std::exception_ptr exception;
+         };
+      private:
+         std::mutex mutex;
+         std::condition_variable stealable;
+         std::condition_variable finished;
+         std::list<Batch*> batches;
+         std::size_t idle_workers;
+         std::size_t active_helpers;
+         bool stopped;
+         std::list<JoiningThread> helpers; // destroyed first, the helpers access the other members.
+      private:
+         /// Loop of a helper thread.
+         void help();
+         /// Executes the next task of the batch, the lock is released meanwhile.
+         void execute(Batch&, std::unique_lock<std::mutex>&);
+   };
+}